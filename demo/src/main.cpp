@@ -12,6 +12,8 @@
 #include "engine/ecs/systems/CollisionSystem.h"
 #include "engine/ecs/systems/CameraSystem.h"
 #include <SDL.h>
+#include <cstdlib>
+#include <cstring>
 
 // ─────────────────────────────────────────────────────────────
 // Demo: mundo Stardew Valley con tilemap, casa, arboles, granja,
@@ -144,8 +146,12 @@ static void makeStaticSprite(eng::ecs::Registry& reg, eng::TextureHandle tex,
     c.isSolid   = true;
 }
 
-// Helper: crea un NPC animado
-static void makeAnimatedNPC(eng::ecs::Registry& reg, eng::TextureHandle tex,
+// Helper: crea un NPC animado. Los clips son del AnimationLibrary (un set
+// compartido por todos los NPCs del mismo sprite sheet); frameDur solo
+// cambia el ritmo de este NPC via speed. Es un idle en loop, asi que usa
+// TimedSpriteAnimator: AnimationSystem no lo recorre y el frame se calcula
+// al dibujarlo.
+static void makeAnimatedNPC(eng::ecs::Registry& reg, eng::TextureHandle tex, eng::ClipSetHandle clips,
                             float x, float y, int cols, int rows, float frameDur) {
     auto e = reg.create();
     auto& t = reg.emplace<eng::ecs::Transform2D>(e);
@@ -167,8 +173,11 @@ static void makeAnimatedNPC(eng::ecs::Registry& reg, eng::TextureHandle tex,
     c.offsetY   = 0.5f;
     c.isSolid   = true;
 
-    auto& a = reg.emplace<eng::ecs::SpriteAnimator>(e);
-    a.clips.push_back({"idle", eng::framesFromGrid(cols, rows, 0), frameDur, true});
+    const eng::AnimationLibrary& library = *reg.ctx().animations;
+    auto& a = reg.emplace<eng::ecs::TimedSpriteAnimator>(e);
+    a.clipSet   = clips;
+    a.speed     = library.clip(clips, 0).frameDuration / frameDur;
+    a.startTime = library.now();
 }
 
 // Helper: dibuja un borde de agua (rectángulo con bordes)
@@ -226,9 +235,19 @@ static void makePathV(std::vector<uint16_t>& tiles, int mapW,
     tiles[y2 * mapW + x + 2] = PATH_BR;
 }
 
-int main(int, char**) {
+int main(int argc, char** argv) {
+    // --pipelined: render en un thread aparte (EngineConfig::pipelinedRender).
+    // --trace N: captura los primeros N frames en trace.json (Perfetto).
+    eng::EngineConfig config;
+    int traceFrames = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--pipelined") == 0) config.pipelinedRender = true;
+        if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) traceFrames = std::atoi(argv[++i]);
+    }
+
     eng::Engine engine;
-    if (!engine.init()) return 1;
+    if (!engine.init(config)) return 1;
+    if (traceFrames > 0) engine.profiler().captureTrace((size_t)traceFrames, "trace.json");
 
     eng::Input::bind(eng::Action::Pause,     SDL_SCANCODE_P);
     eng::Input::bind(eng::Action::Step,      SDL_SCANCODE_O);
@@ -261,11 +280,14 @@ int main(int, char**) {
     pt.prevPosition = pt.position;
     pv.velocity     = {0.0f, 0.0f};
 
+    // Clips: 0=idle, 1=walk_down, 2=walk_up, 3=walk_side (PlayerControlSystem)
     auto& anim = reg.emplace<eng::ecs::SpriteAnimator>(player);
-    anim.clips.push_back({"idle",      eng::framesFromGrid(6, 10, 0), 0.2f,  true});
-    anim.clips.push_back({"walk_down", eng::framesFromGrid(6, 10, 3), 0.12f, true});
-    anim.clips.push_back({"walk_up",   eng::framesFromGrid(6, 10, 5), 0.12f, true});
-    anim.clips.push_back({"walk_side", eng::framesFromGrid(6, 10, 4), 0.12f, true});
+    anim.clipSet = engine.animations().addClipSet({
+        {"idle",      eng::framesFromGrid(6, 10, 0), 0.2f,  true},
+        {"walk_down", eng::framesFromGrid(6, 10, 3), 0.12f, true},
+        {"walk_up",   eng::framesFromGrid(6, 10, 5), 0.12f, true},
+        {"walk_side", eng::framesFromGrid(6, 10, 4), 0.12f, true},
+    });
 
     // Collider chico en los pies del personaje.
     // offset (0, +0.6) lo baja desde el centro del sprite hacia los pies.
@@ -349,23 +371,32 @@ int main(int, char**) {
     // NPCs Y ANIMALES
     // ================================================================
 
+    // Un set de clips por layout de sprite sheet: todos los animales son
+    // hojas 2x2 con el idle en la fila 0, asi que comparten el mismo set.
+    const eng::ClipSetHandle skeletonClips = engine.animations().addClipSet({
+        {"idle", eng::framesFromGrid(6, 10, 0), 0.25f, true},
+    });
+    const eng::ClipSetHandle animalClips = engine.animations().addClipSet({
+        {"idle", eng::framesFromGrid(2, 2, 0), 0.3f, true},
+    });
+
     // ── Skeleton custodiando el bosque ──
-    makeAnimatedNPC(reg, texSkeleton, 10.0f, -5.0f, 6, 10, 0.25f);
-    makeAnimatedNPC(reg, texSkeleton, 13.0f, -2.0f, 6, 10, 0.3f);
+    makeAnimatedNPC(reg, texSkeleton, skeletonClips, 10.0f, -5.0f, 6, 10, 0.25f);
+    makeAnimatedNPC(reg, texSkeleton, skeletonClips, 13.0f, -2.0f, 6, 10, 0.3f);
 
     // ── Animales en la granja (suroeste) ──
-    makeAnimatedNPC(reg, texChicken, -12.0f, 6.0f,  2, 2, 0.3f);
-    makeAnimatedNPC(reg, texChicken, -11.0f, 7.0f,  2, 2, 0.35f);
-    makeAnimatedNPC(reg, texChicken, -13.0f, 7.5f,  2, 2, 0.28f);
-    makeAnimatedNPC(reg, texSheep,   -10.0f, 5.0f,  2, 2, 0.4f);
-    makeAnimatedNPC(reg, texSheep,   -9.0f,  6.5f,  2, 2, 0.38f);
-    makeAnimatedNPC(reg, texCow,     -14.0f, 4.5f,  2, 2, 0.45f);
-    makeAnimatedNPC(reg, texCow,     -13.0f, 5.5f,  2, 2, 0.42f);
-    makeAnimatedNPC(reg, texPig,     -11.5f, 4.0f,  2, 2, 0.35f);
+    makeAnimatedNPC(reg, texChicken, animalClips, -12.0f, 6.0f,  2, 2, 0.3f);
+    makeAnimatedNPC(reg, texChicken, animalClips, -11.0f, 7.0f,  2, 2, 0.35f);
+    makeAnimatedNPC(reg, texChicken, animalClips, -13.0f, 7.5f,  2, 2, 0.28f);
+    makeAnimatedNPC(reg, texSheep,   animalClips, -10.0f, 5.0f,  2, 2, 0.4f);
+    makeAnimatedNPC(reg, texSheep,   animalClips, -9.0f,  6.5f,  2, 2, 0.38f);
+    makeAnimatedNPC(reg, texCow,     animalClips, -14.0f, 4.5f,  2, 2, 0.45f);
+    makeAnimatedNPC(reg, texCow,     animalClips, -13.0f, 5.5f,  2, 2, 0.42f);
+    makeAnimatedNPC(reg, texPig,     animalClips, -11.5f, 4.0f,  2, 2, 0.35f);
 
     // ── Animales sueltos cerca del lago ──
-    makeAnimatedNPC(reg, texChicken, 5.0f,  10.0f, 2, 2, 0.32f);
-    makeAnimatedNPC(reg, texSheep,   7.0f,  9.0f,  2, 2, 0.4f);
+    makeAnimatedNPC(reg, texChicken, animalClips, 5.0f,  10.0f, 2, 2, 0.32f);
+    makeAnimatedNPC(reg, texSheep,   animalClips, 7.0f,  9.0f,  2, 2, 0.4f);
 
     // ================================================================
     // TILEMAP (40x30)
@@ -571,15 +602,27 @@ int main(int, char**) {
     // ================================================================
     // REGISTRAR SISTEMAS
     // ================================================================
+    // Los sistemas que declaran sus accesos (SystemAccess) pueden correr en
+    // paralelo con los de su fase que no chocan; Input, Render y DebugUI
+    // tocan SDL/GL/ImGui y quedan sin declarar (corren solos).
     using Phase = eng::ecs::Phase;
+    using Access = eng::ecs::SystemAccess;
     sched.addSystem("InputSystem",          Phase::Update,          10,     eng::ecs::systems::InputSystem);
-    sched.addSystem("PlayerControlSystem",  Phase::FixedUpdate,     150,    eng::ecs::systems::PlayerControlSystem);
-    sched.addSystem("MovementSystem",       Phase::FixedUpdate,     200,    eng::ecs::systems::MovementSystem);
-    sched.addSystem("CollisionSystem",      Phase::FixedUpdate,     250,    eng::ecs::systems::CollisionSystem);
-    sched.addSystem("AnimationSystem",      Phase::Update,          300,    eng::ecs::systems::AnimationSystem);
-    sched.addSystem("CameraSystem",         Phase::Render,          50,     eng::ecs::systems::CameraSystem);
+    sched.addSystem("PlayerControlSystem",  Phase::FixedUpdate,     150,    eng::ecs::systems::PlayerControlSystem,
+                    Access().read<eng::ecs::PlayerTag, eng::Input>().write<eng::ecs::Velocity2D, eng::ecs::SpriteAnimator, eng::ecs::Sprite>());
+    sched.addSystem("MovementSystem",       Phase::FixedUpdate,     200,    eng::ecs::systems::MovementSystem,
+                    Access().read<eng::ecs::Velocity2D>().write<eng::ecs::Transform2D, eng::ecs::SoAMotionPool>());
+    sched.addSystem("CollisionSystem",      Phase::FixedUpdate,     250,    eng::ecs::systems::CollisionSystem,
+                    Access().read<eng::ecs::Velocity2D, eng::ecs::BoxCollision, eng::ecs::Tilemap, eng::ecs::TileCollisionLayer>().write<eng::ecs::Transform2D>());
+    sched.addSystem("AnimationSystem",      Phase::Update,          300,    eng::ecs::systems::AnimationSystem,
+                    Access().write<eng::ecs::SpriteAnimator, eng::ecs::Sprite, eng::AnimationLibrary>());
+    sched.addSystem("CameraSystem",         Phase::Render,          50,     eng::ecs::systems::CameraSystem,
+                    Access().read<eng::ecs::PlayerTag, eng::ecs::Transform2D>().write<eng::ecs::Camera, eng::Renderer2D>());
     sched.addSystem("RenderSystem",         Phase::Render,          100,    eng::ecs::systems::RenderSystem);
     sched.addSystem("DebugUISystem",        Phase::Update,          900,    eng::ecs::systems::DebugUISystem);
+#ifndef NDEBUG
+    sched.setValidateAccess(true);
+#endif
     engine.run();
     engine.shutdown();
     return 0;
@@ -0,0 +1,118 @@
+#include "Bench.h"
+#include "engine/ecs/Registry.h"
+#include "engine/ecs/ArchetypeRegistry.h"
+#include "engine/ecs/Components.h"
+
+#include <string>
+
+namespace eng::bench {
+
+using namespace eng::ecs;
+
+// Escena estilo demo escalada: por cada 10 entidades hay 6 props estaticos
+// (arboles, casas: Transform2D + Sprite + BoxCollision), 3 animales
+// animados (+ SpriteAnimator) y 1 que se mueve (+ Velocity2D).
+// Templateado sobre el registry para construir la MISMA escena en ambos
+// backends.
+template <typename Reg>
+static void buildScene(Reg& reg, size_t count, ClipSetHandle idle) {
+
+    for (size_t i = 0; i < count; ++i) {
+        Entity e = reg.create();
+        const float x = static_cast<float>(i % 1000);
+        const float y = static_cast<float>(i / 1000);
+
+        auto& t = reg.template emplace<Transform2D>(e);
+        t.position = {x, y};
+        t.prevPosition = t.position;
+
+        auto& s = reg.template emplace<Sprite>(e);
+        s.width = 2.0f;
+        s.height = 2.0f;
+
+        auto& c = reg.template emplace<BoxCollision>(e);
+        c.width = 0.8f;
+        c.height = 0.5f;
+        c.isSolid = true;
+
+        const size_t kind = i % 10;
+        if (kind >= 6 && kind < 9) {
+            auto& a = reg.template emplace<SpriteAnimator>(e);
+            a.clipSet = idle;
+        } else if (kind == 9) {
+            reg.template emplace<Velocity2D>(e).velocity = {1.0f, 0.5f};
+        }
+    }
+}
+
+template <typename Reg>
+static void runBackend(Runner& runner, const std::string& backend, size_t count) {
+    constexpr float dt = 1.0f / 60.0f;
+
+    AnimationLibrary library;
+    const ClipSetHandle idle = library.addClipSet({
+        AnimationClip{"idle", eng::framesFromGrid(2, 2, 0), 0.3f, true},
+    });
+
+    double msBuild = measureMs([&] {
+        Reg reg;
+        buildScene(reg, count, idle);
+    }, 1);
+    runner.add("storage", backend + " build scene", count, msBuild);
+
+    Reg reg;
+    buildScene(reg, count, idle);
+
+    const size_t moving = reg.template componentCount<Velocity2D>();
+    double msMove = measureMs([&] {
+        reg.template view<Transform2D, Velocity2D>().each([](Transform2D& t, Velocity2D& v) {
+            t.prevPosition = t.position;
+            t.position.x += v.velocity.x * dt;
+            t.position.y += v.velocity.y * dt;
+        });
+    });
+    runner.add("storage", backend + " view<Transform2D, Velocity2D>", moving, msMove);
+
+    const size_t sprites = reg.template componentCount<Sprite>();
+    double msSprites = measureMs([&] {
+        float acc = 0.0f;
+        reg.template view<Transform2D, Sprite>().each([&](Transform2D& t, Sprite& s) {
+            acc += t.position.y + s.height * 0.5f;
+        });
+        doNotOptimize(acc);
+    });
+    runner.add("storage", backend + " view<Transform2D, Sprite>", sprites, msSprites);
+
+    const size_t animated = reg.template componentCount<SpriteAnimator>();
+    double msAnim = measureMs([&] {
+        reg.template view<SpriteAnimator, Sprite, Transform2D>().each(
+            [&library](SpriteAnimator& a, Sprite& s, Transform2D&) {
+                a.timer += dt;
+                s.uvRect = library.frame(library.clip(a.clipSet, 0), a.currentFrame);
+            });
+    });
+    runner.add("storage", backend + " view<SpriteAnimator, Sprite, Transform2D>", animated, msAnim);
+
+    // Cambio estructural: agregar y quitar Velocity2D a los props estaticos
+    // (en archetypes mueve la fila completa entre chunks).
+    std::vector<Entity> statics;
+    reg.template view<BoxCollision>().each([&](Entity e, BoxCollision&) {
+        if (!reg.template has<SpriteAnimator>(e) && !reg.template has<Velocity2D>(e)) {
+            statics.push_back(e);
+        }
+    });
+    double msChurn = measureMs([&] {
+        for (Entity e : statics) reg.template emplace<Velocity2D>(e);
+        for (Entity e : statics) reg.template remove<Velocity2D>(e);
+    }, 3);
+    runner.add("storage", backend + " emplace+remove Velocity2D", statics.size(), msChurn);
+}
+
+void runArchetypeBench(Runner& runner) {
+    for (size_t count : {100'000u, 500'000u}) {
+        runBackend<Registry>(runner, "sparse-set", count);
+        runBackend<ArchetypeRegistry>(runner, "archetype", count);
+    }
+}
+
+} // namespace eng::bench
@@ -0,0 +1,130 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+namespace eng::bench {
+
+/// Metrica extra de un resultado (bytes por frame, flushes...).
+using Metric = std::pair<std::string, double>;
+
+/// Resultado de una medicion. nsPerItem = tiempo / cantidad de elementos
+/// procesados (entidades, quads, etc.) para comparar entre escalas.
+struct Result {
+    std::string suite;
+    std::string name;
+    size_t      items = 0;
+    double      ms = 0.0;
+    double      nsPerItem = 0.0;
+    std::vector<Metric> metrics;
+};
+
+/// Acumula resultados y los imprime al final como tabla.
+class Runner {
+public:
+    void add(const std::string& suite, const std::string& name, size_t items, double ms,
+             std::vector<Metric> metrics = {}) {
+        Result r;
+        r.suite = suite;
+        r.name = name;
+        r.items = items;
+        r.ms = ms;
+        r.nsPerItem = items ? (ms * 1e6) / static_cast<double>(items) : 0.0;
+        r.metrics = std::move(metrics);
+        m_results.push_back(std::move(r));
+    }
+
+    void printTable() const {
+        std::printf("%-10s %-40s %10s %12s %12s\n", "suite", "benchmark", "items", "ms", "ns/item");
+        for (const auto& r : m_results) {
+            std::printf("%-10s %-40s %10zu %12.3f %12.2f",
+                        r.suite.c_str(), r.name.c_str(), r.items, r.ms, r.nsPerItem);
+            for (const Metric& m : r.metrics) std::printf("  %s=%.0f", m.first.c_str(), m.second);
+            std::printf("\n");
+        }
+    }
+
+    /// Los resultados como JSON, para comparar entre versiones:
+    /// {"schema":1, "debug":bool, "hardwareThreads":N, "results":[{suite,
+    /// name, items, ms, nsPerItem, metrics:{...}}, ...]}. ms es el mejor de
+    /// las corridas.
+    void writeJson(std::FILE* f) const {
+#ifdef NDEBUG
+        const bool debug = false;
+#else
+        const bool debug = true;
+#endif
+        std::fprintf(f, "{\n  \"schema\": 1,\n  \"debug\": %s,\n  \"hardwareThreads\": %u,\n  \"results\": [",
+                     debug ? "true" : "false", std::thread::hardware_concurrency());
+        for (size_t i = 0; i < m_results.size(); ++i) {
+            const Result& r = m_results[i];
+            std::fprintf(f, "%s\n    {\"suite\": ", i ? "," : "");
+            writeJsonString(f, r.suite);
+            std::fprintf(f, ", \"name\": ");
+            writeJsonString(f, r.name);
+            std::fprintf(f, ", \"items\": %zu, \"ms\": %.6f, \"nsPerItem\": %.4f, \"metrics\": {",
+                         r.items, r.ms, r.nsPerItem);
+            for (size_t m = 0; m < r.metrics.size(); ++m) {
+                std::fprintf(f, "%s", m ? ", " : "");
+                writeJsonString(f, r.metrics[m].first);
+                std::fprintf(f, ": %.17g", r.metrics[m].second);
+            }
+            std::fprintf(f, "}}");
+        }
+        std::fprintf(f, "\n  ]\n}\n");
+    }
+
+    const std::vector<Result>& results() const { return m_results; }
+
+private:
+    static void writeJsonString(std::FILE* f, std::string_view str) {
+        std::fputc('"', f);
+        for (char c : str) {
+            if (c == '"' || c == '\\') std::fputc('\\', f);
+            std::fputc(c, f);
+        }
+        std::fputc('"', f);
+    }
+
+    std::vector<Result> m_results;
+};
+
+/// Corre fn `reps` veces y retorna el MEJOR tiempo en ms.
+/// Usamos el minimo (no el promedio) porque es el menos sensible a ruido
+/// del scheduler del SO y de otros procesos.
+template <typename Fn>
+double measureMs(Fn&& fn, int reps = 5) {
+    double best = 1e300;
+    for (int i = 0; i < reps; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        auto t1 = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        best = std::min(best, ms);
+    }
+    return best;
+}
+
+/// Corridas por medicion segun la escala: a 1M entidades una corrida ya
+/// dura lo suficiente y 5 harian eterno el suite.
+inline int repsFor(size_t count) {
+    return count >= 1'000'000 ? 2 : 5;
+}
+
+/// Evita que el optimizador elimine calculos cuyo resultado no se usa.
+template <typename T>
+inline void doNotOptimize(T const& value) {
+#if defined(_MSC_VER)
+    static volatile const T* sink;
+    sink = &value;
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+} // namespace eng::bench
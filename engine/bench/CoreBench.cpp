@@ -0,0 +1,84 @@
+#include "Bench.h"
+#include "engine/ecs/Registry.h"
+#include "engine/ecs/Components.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace eng::bench {
+
+using namespace eng::ecs;
+
+// Operaciones basicas del Registry a 1k / 100k / 1M entidades: churn de
+// create/destroy, emplace/remove, views de uno y dos componentes y get
+// con acceso aleatorio.
+void runCoreBench(Runner& runner) {
+    constexpr float dt = 1.0f / 60.0f;
+
+    for (size_t count : {1'000u, 100'000u, 1'000'000u}) {
+        const int reps = repsFor(count);
+
+        Registry reg;
+        std::vector<Entity> entities(count);
+        for (size_t i = 0; i < count; ++i) {
+            Entity e = reg.create();
+            reg.emplace<Transform2D>(e).position = {static_cast<float>(i), 0.0f};
+            if (i % 2 == 0) reg.emplace<Velocity2D>(e).velocity = {1.0f, 0.5f};
+            entities[i] = e;
+        }
+
+        // Churn: destruir la mitad (intercalada) y volver a crearla; los
+        // indices salen de la free list y las versiones suben.
+        double msChurn = measureMs([&] {
+            for (size_t i = 1; i < count; i += 2) reg.destroy(entities[i]);
+            for (size_t i = 1; i < count; i += 2) {
+                entities[i] = reg.create();
+                reg.emplace<Transform2D>(entities[i]);
+            }
+        }, reps);
+        runner.add("core", "create/destroy churn (half)", count, msChurn);
+
+        // Agregar y sacar un componente a entidades que ya existen.
+        double msEmplace = measureMs([&] {
+            for (Entity e : entities) reg.emplace<Sprite>(e);
+            for (Entity e : entities) reg.remove<Sprite>(e);
+        }, reps);
+        runner.add("core", "emplace+remove Sprite", count, msEmplace);
+
+        double msSingle = measureMs([&] {
+            float sum = 0.0f;
+            for (auto [e, t] : reg.view<const Transform2D>()) {
+                (void)e;
+                sum += t.position.x;
+            }
+            doNotOptimize(sum);
+        }, reps);
+        runner.add("core", "view<Transform2D>", count, msSingle);
+
+        const size_t moving = reg.componentCount<Velocity2D>();
+        double msMulti = measureMs([&] {
+            for (auto [e, t, v] : reg.view<Transform2D, const Velocity2D>()) {
+                (void)e;
+                t.prevPosition = t.position;
+                t.position.x += v.velocity.x * dt;
+                t.position.y += v.velocity.y * dt;
+            }
+        }, reps);
+        runner.add("core", "view<Transform2D, Velocity2D>", moving, msMulti);
+
+        // get<T> con un orden aleatorio fijo (sin localidad en el sparse ni
+        // en el dense).
+        std::vector<Entity> shuffled = entities;
+        std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937{42});
+        const Registry& creg = reg;
+        double msGet = measureMs([&] {
+            float sum = 0.0f;
+            for (Entity e : shuffled) sum += creg.get<Transform2D>(e).position.x;
+            doNotOptimize(sum);
+        }, reps);
+        runner.add("core", "get<Transform2D> random access", count, msGet);
+    }
+}
+
+} // namespace eng::bench
@@ -0,0 +1,120 @@
+#include "Bench.h"
+#include "engine/JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace eng::bench {
+
+// Stress: si un resultado no da lo esperado el bench aborta (un job
+// perdido o duplicado no tiene que pasar desapercibido detras de un
+// numero de throughput).
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        std::fprintf(stderr, "JobBench: FAILED %s\n", what);
+        std::abort();
+    }
+}
+
+// Arbol binario de jobs: cada nodo encola sus dos hijos desde adentro de un
+// job, asi que el trabajo nace en la cola de un worker y los demas lo
+// tienen que robar.
+static void spawnTree(JobSystem& jobs, JobCounter& counter, int depth, std::atomic<size_t>& leaves) {
+    if (depth == 0) {
+        leaves.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    for (int i = 0; i < 2; ++i) {
+        jobs.run([&jobs, &counter, depth, &leaves] { spawnTree(jobs, counter, depth - 1, leaves); }, &counter);
+    }
+}
+
+static void runJobSuite(Runner& runner, unsigned threads) {
+    JobSystem jobs(threads - 1);
+    const std::string suffix = " (" + std::to_string(threads) + " threads)";
+
+    // Throughput: jobs vacios encolados desde el main thread.
+    constexpr size_t emptyJobs = 200'000;
+    double msEmpty = measureMs([&] {
+        std::atomic<size_t> ran{0};
+        JobCounter counter;
+        for (size_t i = 0; i < emptyJobs; ++i) {
+            jobs.run([&ran] { ran.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        }
+        jobs.wait(counter);
+        check(ran.load() == emptyJobs, "empty jobs");
+    });
+    runner.add("jobs", "run + wait (empty jobs)" + suffix, emptyJobs, msEmpty);
+
+    // Work-stealing: arbol de 2^16 hojas generado desde los workers.
+    constexpr int depth = 16;
+    constexpr size_t treeLeaves = size_t{1} << depth;
+    double msTree = measureMs([&] {
+        std::atomic<size_t> leaves{0};
+        JobCounter counter;
+        jobs.run([&] { spawnTree(jobs, counter, depth, leaves); }, &counter);
+        jobs.wait(counter);
+        check(leaves.load() == treeLeaves, "spawn tree");
+    });
+    runner.add("jobs", "nested spawn tree" + suffix, treeLeaves * 2 - 1, msTree);
+
+    // Dependencias: cadenas A -> B -> C ... con runAfter. Cada cadena tiene
+    // que ejecutarse en orden (el paso i ve el valor que dejo el i-1).
+    constexpr size_t chains = 2'000;
+    constexpr size_t chainLength = 16;
+    double msChains = measureMs([&] {
+        std::vector<size_t> values(chains, 0);
+        std::vector<JobCounter> steps(chains * chainLength);
+        for (size_t c = 0; c < chains; ++c) {
+            size_t* value = &values[c];
+            for (size_t s = 0; s < chainLength; ++s) {
+                JobCounter& step = steps[c * chainLength + s];
+                auto fn = [value, s] {
+                    check(*value == s, "dependency order");
+                    *value = s + 1;
+                };
+                if (s == 0) {
+                    jobs.run(fn, &step);
+                } else {
+                    jobs.runAfter(steps[c * chainLength + s - 1], fn, &step);
+                }
+            }
+        }
+        for (JobCounter& step : steps) jobs.wait(step);
+        for (size_t v : values) check(v == chainLength, "dependency chains");
+    });
+    runner.add("jobs", "runAfter chains (16 deep)" + suffix, chains * chainLength, msChains);
+
+    // parallelFor con trabajo desparejo: los rangos altos cuestan mas.
+    constexpr size_t items = 1'000'000;
+    double msFor = measureMs([&] {
+        std::atomic<uint64_t> acc{0};
+        jobs.parallelFor(items, 1024, [&](size_t begin, size_t end) {
+            uint64_t local = 0;
+            for (size_t i = begin; i < end; ++i) {
+                const size_t spin = (i * 4) / items;
+                for (size_t k = 0; k <= spin; ++k) local += (i ^ k) & 7;
+            }
+            acc.fetch_add(local, std::memory_order_relaxed);
+        });
+        doNotOptimize(acc.load());
+    });
+    runner.add("jobs", "parallelFor (uneven)" + suffix, items, msFor);
+}
+
+void runJobBench(Runner& runner) {
+    // 1 thread (sin workers, todo inline), 2, 4... hasta hardware_concurrency().
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts{1};
+    for (unsigned t = 2; t <= hw; t *= 2) threadCounts.push_back(t);
+    if (hw > 1 && threadCounts.back() != hw) threadCounts.push_back(hw);
+
+    for (unsigned threads : threadCounts) runJobSuite(runner, threads);
+}
+
+} // namespace eng::bench
@@ -0,0 +1,49 @@
+#include "Bench.h"
+#include "engine/ecs/Registry.h"
+#include "engine/ecs/Components.h"
+#include "engine/ecs/SoAMotion.h"
+
+#include <string>
+
+namespace eng::bench {
+
+using namespace eng::ecs;
+
+// Integracion de movimiento a escala: N entidades moviendose, mismo
+// trabajo (prev = pos; pos += vel * dt) en AoS (owning group de
+// Transform2D + Velocity2D) y en SoA (reg.motion() + kernel SIMD).
+void runMotionBench(Runner& runner) {
+    constexpr float dt = 1.0f / 60.0f;
+    const std::string kernel = motionKernelName();
+
+    for (size_t count : {100'000u, 1'000'000u}) {
+        {
+            Registry reg;
+            for (size_t i = 0; i < count; ++i) {
+                Entity e = reg.create();
+                reg.emplace<Transform2D>(e).position = {static_cast<float>(i), 0.0f};
+                reg.emplace<Velocity2D>(e).velocity = {1.0f, 0.5f};
+            }
+            auto group = reg.group<Transform2D, Velocity2D>();
+            double ms = measureMs([&] {
+                group.each([](Transform2D& t, Velocity2D& v) {
+                    t.prevPosition = t.position;
+                    t.position.x += v.velocity.x * dt;
+                    t.position.y += v.velocity.y * dt;
+                });
+            });
+            runner.add("motion", "AoS group<Transform2D, Velocity2D>", count, ms);
+        }
+        {
+            Registry reg;
+            reg.motion().reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                reg.motion().add(reg.create(), {static_cast<float>(i), 0.0f}, {1.0f, 0.5f});
+            }
+            double ms = measureMs([&] { reg.motion().integrate(dt); });
+            runner.add("motion", "SoA motion pool (" + kernel + ")", count, ms);
+        }
+    }
+}
+
+} // namespace eng::bench
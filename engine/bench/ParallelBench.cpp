@@ -0,0 +1,64 @@
+#include "Bench.h"
+#include "engine/ecs/Registry.h"
+#include "engine/ecs/Components.h"
+#include "engine/JobSystem.h"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace eng::bench {
+
+using namespace eng::ecs;
+
+// 500k NPCs animados: mismo trabajo que AnimationSystem, secuencial
+// (Group::each) vs Group::parallelEach con distintas cantidades de workers.
+void runParallelBench(Runner& runner) {
+    constexpr size_t count = 500'000;
+    constexpr float dt = 1.0f / 60.0f;
+
+    AnimationLibrary library;
+    const ClipSetHandle walk = library.addClipSet({
+        AnimationClip{"walk", eng::framesFromGrid(4, 4, 0), 0.1f, true},
+    });
+
+    Registry reg;
+    for (size_t i = 0; i < count; ++i) {
+        Entity e = reg.create();
+        auto& a = reg.emplace<SpriteAnimator>(e);
+        a.clipSet = walk;
+        a.timer = static_cast<float>(i % 7) * 0.013f;
+        reg.emplace<Sprite>(e);
+    }
+    auto group = reg.group<SpriteAnimator, Sprite>();
+
+    auto animate = [&library](SpriteAnimator& a, Sprite& s) {
+        const AnimationLibrary::Clip& clip = library.clip(a.clipSet, a.currentClip);
+        a.timer += dt;
+        while (a.timer >= clip.frameDuration) {
+            a.timer -= clip.frameDuration;
+            a.currentFrame = static_cast<uint16_t>((a.currentFrame + 1) % clip.frameCount);
+        }
+        s.uvRect = library.frame(clip, a.currentFrame);
+    };
+
+    double msSeq = measureMs([&] { group.each(animate); });
+    runner.add("parallel", "Group::each (1 thread)", count, msSeq);
+
+    // 2, 4, 8... hasta hardware_concurrency() (y el maximo si no es potencia de 2).
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned t = 2; t <= hw; t *= 2) threadCounts.push_back(t);
+    if (hw > 1 && threadCounts.back() != hw) threadCounts.push_back(hw);
+
+    for (unsigned threads : threadCounts) {
+        JobSystem jobs(threads - 1);
+        reg.ctx().jobs = &jobs;
+        double ms = measureMs([&] { group.parallelEach(animate); });
+        runner.add("parallel", "Group::parallelEach (" + std::to_string(threads) + " threads)", count, ms);
+        reg.ctx().jobs = nullptr;
+    }
+}
+
+} // namespace eng::bench
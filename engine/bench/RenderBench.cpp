@@ -0,0 +1,145 @@
+#include "Bench.h"
+#include "engine/ecs/Registry.h"
+#include "engine/ecs/Components.h"
+#include "engine/ecs/systems/RenderSystem.h"
+#include "engine/render/AnimationLibrary.h"
+#include "engine/render/NullRenderBackend.h"
+#include "engine/render/Renderer2D.h"
+#include "engine/render/TextureManager.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace eng::bench {
+
+using namespace eng::ecs;
+using namespace eng::ecs::systems;
+
+// Costo de CPU del render sin GL: Renderer2D con NullRenderBackend,
+// RenderSystem (+ TilemapRenderSystem) sobre un mapa de 1024x1024 tiles
+// con 100k sprites. Reporta ns/quad (items = quads submitidos), bytes de
+// vertices por frame y flushes/draw calls.
+static std::vector<Metric> frameMetrics(const RendererStats& stats) {
+    return {
+        {"bytes/frame", static_cast<double>(stats.uploadBytes)},
+        {"flushes", static_cast<double>(stats.flushes)},
+        {"draws", static_cast<double>(stats.drawCalls)},
+        {"slotOverflows", static_cast<double>(stats.slotOverflows)},
+    };
+}
+
+void runRenderBench(Runner& runner) {
+    constexpr int mapSize = 1024;
+    constexpr size_t spriteCount = 100'000;
+    constexpr int sheetCount = 4;
+
+    NullRenderBackend backend;
+    Renderer2D renderer(backend);
+    renderer.init();
+
+    // Ids de textura inventados (el backend no los mira).
+    TextureManager textures;
+    textures.add({NullRenderBackend::WhiteTexture, 1, 1}); // handle 0
+    const TextureHandle tilesetTex = textures.add({100, 256, 256});
+    TextureHandle sheets[sheetCount];
+    for (int i = 0; i < sheetCount; ++i) sheets[i] = textures.add({200u + static_cast<uint32_t>(i), 384, 640});
+
+    AnimationLibrary library;
+    const ClipSetHandle walk = library.addClipSet({
+        AnimationClip{"walk", eng::framesFromGrid(6, 10, 1), 0.1f, true},
+    });
+
+    // ── Raw: Renderer2D sin ECS, mismos quads que un frame tipico ──
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+        const Rect uv{0.0f, 0.0f, 1.0f / 6.0f, 1.0f / 10.0f};
+        const ecs::Color4 tint{1.0f, 1.0f, 1.0f, 1.0f};
+        std::vector<glm::vec2> centers(spriteCount);
+        for (auto& c : centers) c = {pos(rng), pos(rng)};
+
+        auto frame = [&] {
+            renderer.beginFrame(1920, 1080);
+            renderer.setCamera({0.0f, 0.0f}, 64.0f);
+            for (size_t i = 0; i < spriteCount; ++i) {
+                renderer.submitTexturedQuad(centers[i], 1.0f, 1.0f, 200u + static_cast<uint32_t>(i % sheetCount),
+                                            uv, tint);
+            }
+            renderer.flush();
+            renderer.endFrame();
+        };
+        double ms = measureMs(frame);
+        const RendererStats stats = renderer.stats();
+        runner.add("render", "Renderer2D submit (no ECS)", stats.quads, ms, frameMetrics(stats));
+    }
+
+    // ── Escena: tilemap de 2 capas + sprites (1/4 animados sin estado) ──
+    Registry reg;
+    reg.setContext({nullptr, &renderer, nullptr, nullptr, &textures, nullptr, &library});
+    {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> tile(1, 256);
+        std::uniform_real_distribution<float> pos(0.0f, static_cast<float>(mapSize));
+
+        Entity map = reg.create();
+        reg.emplace<Transform2D>(map);
+        auto& tm = reg.emplace<Tilemap>(map);
+        tm.tileset = Tileset(tilesetTex, 16, 16, 256, 256);
+        tm.width = mapSize;
+        tm.height = mapSize;
+        tm.layers.resize(2);
+        tm.layers[0].tiles.resize(static_cast<size_t>(mapSize) * mapSize);
+        tm.layers[1].tiles.resize(static_cast<size_t>(mapSize) * mapSize, 0);
+        tm.layers[1].renderOrder = 1;
+        for (size_t i = 0; i < tm.layers[0].tiles.size(); ++i) {
+            tm.layers[0].tiles[i] = static_cast<uint16_t>(tile(rng));
+            if (i % 10 == 0) tm.layers[1].tiles[i] = static_cast<uint16_t>(tile(rng));
+        }
+
+        // Creados ya ordenados por Y: es el estado estable del pool en el
+        // juego (RenderSystem lo reordena con insertion sort, O(n) sobre
+        // datos casi ordenados pero O(n^2) sobre un pool aleatorio).
+        std::vector<glm::vec2> positions(spriteCount);
+        for (auto& p : positions) p = {pos(rng), pos(rng)};
+        std::sort(positions.begin(), positions.end(),
+                  [](const glm::vec2& a, const glm::vec2& b) { return a.y < b.y; });
+
+        for (size_t i = 0; i < spriteCount; ++i) {
+            Entity e = reg.create();
+            auto& t = reg.emplace<Transform2D>(e);
+            t.position = t.prevPosition = positions[i];
+            auto& s = reg.emplace<Sprite>(e);
+            s.texture = sheets[i % sheetCount];
+            s.uvRect = {0.0f, 0.0f, 1.0f / 6.0f, 1.0f / 10.0f};
+            s.width = s.height = 2.0f;
+            s.tint = {1.0f, 1.0f, 1.0f, 1.0f};
+            if (i % 4 == 0) reg.emplace<TimedSpriteAnimator>(e).clipSet = walk;
+        }
+
+        Entity cam = reg.create();
+        reg.emplace<Camera>(cam).position = {mapSize * 0.5f, mapSize * 0.5f};
+    }
+
+    // 1080p (~30x17 tiles a 64 ppu: domina el culling) y una vista lejana
+    // de 256x256 tiles (~65k tiles + ~6k sprites por frame).
+    struct View {
+        const char* name;
+        int w, h;
+    };
+    for (const View& view : {View{"RenderSystem 1080p view", 1920, 1080},
+                             View{"RenderSystem 256x256-tile view", 16384, 16384}}) {
+        renderer.setTargetSize(view.w, view.h);
+        auto frame = [&] {
+            RenderSystem(reg, 1.0f);
+            renderer.endFrame();
+        };
+        frame(); // calentar buffers de vertices fuera de la medicion
+        double ms = measureMs(frame);
+        const RendererStats stats = renderer.stats();
+        runner.add("render", view.name, stats.quads, ms, frameMetrics(stats));
+    }
+}
+
+} // namespace eng::bench
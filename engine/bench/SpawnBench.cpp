@@ -0,0 +1,98 @@
+#include "Bench.h"
+#include "engine/ecs/Registry.h"
+#include "engine/ecs/Components.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace eng::bench {
+
+using namespace eng::ecs;
+
+// Tipos de relleno: un registry de juego real tiene muchos pools y cada
+// proyectil usa solo unos pocos. Antes destroy() pasaba por todos.
+template <int N> struct Filler { int v = N; };
+
+template <int... Ns>
+static void touchFillers(Registry& reg, Entity e, std::integer_sequence<int, Ns...>) {
+    (reg.emplace<Filler<Ns>>(e), ...);
+}
+
+template <typename T>
+static void runPoolGrowth(Runner& runner, const char* typeName, size_t count) {
+    // Mismas operaciones sobre ComponentStorage<T> y std::vector<T>: crecer
+    // sin reserve y despues swap-remove de la mitad.
+    double msStorage = measureMs([&] {
+        ComponentStorage<T> storage;
+        for (size_t i = 0; i < count; ++i) storage.emplace_back();
+        for (size_t i = 0; i < storage.size(); i += 2) storage.swapRemove(i);
+        doNotOptimize(storage.size());
+    });
+    runner.add("pool growth", std::string("ComponentStorage<") + typeName + ">", count, msStorage);
+
+    double msVector = measureMs([&] {
+        std::vector<T> v;
+        for (size_t i = 0; i < count; ++i) v.emplace_back();
+        for (size_t i = 0; i < v.size(); i += 2) {
+            v[i] = std::move(v.back());
+            v.pop_back();
+        }
+        doNotOptimize(v.size());
+    });
+    runner.add("pool growth", std::string("std::vector<") + typeName + "> (reference)", count, msVector);
+
+    double msPool = measureMs([&] {
+        ComponentPool<T> pool;
+        for (size_t i = 0; i < count; ++i) pool.emplace(Entity{static_cast<uint32_t>(i), 0});
+        doNotOptimize(pool.size());
+    });
+    runner.add("pool growth", std::string("ComponentPool<") + typeName + "> emplace", count, msPool);
+}
+
+// Por tick: spawnear `count` proyectiles (Transform2D + Velocity2D +
+// Sprite) y despues destruirlos todos.
+void runSpawnBench(Runner& runner) {
+    for (size_t count : {1'000u, 10'000u, 100'000u}) {
+        Registry reg;
+        {
+            // Registrar 24 pools extra en uso.
+            Entity e = reg.create();
+            touchFillers(reg, e, std::make_integer_sequence<int, 24>{});
+        }
+
+        std::vector<Entity> entities(count);
+
+        double msSingle = measureMs([&] {
+            for (size_t i = 0; i < count; ++i) {
+                Entity e = reg.create();
+                reg.emplace<Transform2D>(e);
+                reg.emplace<Velocity2D>(e).velocity = {4.0f, 0.0f};
+                reg.emplace<Sprite>(e);
+                entities[i] = e;
+            }
+            for (Entity e : entities) reg.destroy(e);
+        });
+        runner.add("spawn", "create+emplace / destroy per entity", count, msSingle);
+
+        double msBulk = measureMs([&] {
+            reg.create(entities);
+            reg.emplaceRange<Transform2D>(entities);
+            reg.emplaceRange<Velocity2D>(entities, Velocity2D{{4.0f, 0.0f}});
+            reg.emplaceRange<Sprite>(entities);
+            reg.destroy(std::span<const Entity>(entities));
+        });
+        runner.add("spawn", "create(span) + emplaceRange / destroy(span)", count, msBulk);
+    }
+
+    // Crecimiento de pools sin reserve (spawn masivo que no sabe cuantos
+    // van a ser): ComponentStorage crece con realloc para tipos relocatable.
+    // std::vector<T> como referencia.
+    for (size_t count : {100'000u, 1'000'000u}) {
+        runPoolGrowth<Transform2D>(runner, "Transform2D", count);
+        runPoolGrowth<Sprite>(runner, "Sprite", count);
+        runPoolGrowth<SpriteAnimator>(runner, "SpriteAnimator", count / 10);
+    }
+}
+
+} // namespace eng::bench
@@ -0,0 +1,98 @@
+#include "Bench.h"
+#include "engine/ecs/Registry.h"
+#include "engine/ecs/Components.h"
+#include "engine/ecs/systems/MovementSystem.h"
+#include "engine/ecs/systems/AnimationSystem.h"
+#include "engine/ecs/systems/CollisionSystem.h"
+#include "engine/render/AnimationLibrary.h"
+#include "engine/JobSystem.h"
+
+#include <cmath>
+#include <string>
+
+namespace eng::bench {
+
+using namespace eng::ecs;
+using namespace eng::ecs::systems;
+
+// Un tick de los sistemas del demo sobre escenas sinteticas de 1k / 100k /
+// 1M entidades, sin profiler ni ventana. Movement y Animation se miden
+// secuenciales (sin jobs en el ctx) y con el JobSystem; Collision es
+// secuencial.
+void runSystemBench(Runner& runner) {
+    constexpr float dt = 1.0f / 60.0f;
+
+    JobSystem jobs;
+    const std::string threads = " (" + std::to_string(jobs.workerCount() + 1) + " threads)";
+
+    AnimationLibrary library;
+    const ClipSetHandle walk = library.addClipSet({
+        AnimationClip{"walk", eng::framesFromGrid(4, 4, 0), 0.1f, true},
+    });
+
+    for (size_t count : {1'000u, 100'000u, 1'000'000u}) {
+        const int reps = repsFor(count);
+
+        // ── Movement: todas con Transform2D + Velocity2D ──
+        {
+            Registry reg;
+            for (size_t i = 0; i < count; ++i) {
+                Entity e = reg.create();
+                reg.emplace<Transform2D>(e).position = {static_cast<float>(i), 0.0f};
+                reg.emplace<Velocity2D>(e).velocity = {1.0f, 0.5f};
+            }
+            MovementSystem(reg, dt); // crea el owning group fuera de la medicion
+
+            double ms = measureMs([&] { MovementSystem(reg, dt); }, reps);
+            runner.add("systems", "MovementSystem tick", count, ms);
+
+            reg.setContext({nullptr, nullptr, nullptr, nullptr, nullptr, &jobs, nullptr});
+            ms = measureMs([&] { MovementSystem(reg, dt); }, reps);
+            runner.add("systems", "MovementSystem tick" + threads, count, ms);
+        }
+
+        // ── Animation: SpriteAnimator + Sprite con un clip compartido ──
+        {
+            Registry reg;
+            reg.setContext({nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, &library});
+            for (size_t i = 0; i < count; ++i) {
+                Entity e = reg.create();
+                auto& a = reg.emplace<SpriteAnimator>(e);
+                a.clipSet = walk;
+                a.timer = static_cast<float>(i % 7) * 0.013f;
+                reg.emplace<Sprite>(e);
+            }
+            AnimationSystem(reg, dt);
+
+            double ms = measureMs([&] { AnimationSystem(reg, dt); }, reps);
+            runner.add("systems", "AnimationSystem tick", count, ms);
+
+            reg.setContext({nullptr, nullptr, nullptr, nullptr, nullptr, &jobs, &library});
+            ms = measureMs([&] { AnimationSystem(reg, dt); }, reps);
+            runner.add("systems", "AnimationSystem tick" + threads, count, ms);
+        }
+
+        // ── Collision: grilla de colliders solidos, 1 de cada 4 se mueve ──
+        // Separados 1.5 unidades (colliders de 1x1): ~2 por celda del
+        // spatial hash y sin solapes, asi que se mide armar el grid y las
+        // consultas de vecinos, no la resolucion.
+        {
+            Registry reg;
+            const size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+            for (size_t i = 0; i < count; ++i) {
+                Entity e = reg.create();
+                auto& t = reg.emplace<Transform2D>(e);
+                t.position = {static_cast<float>(i % side) * 1.5f, static_cast<float>(i / side) * 1.5f};
+                auto& box = reg.emplace<BoxCollision>(e);
+                box.width = box.height = 1.0f;
+                box.isSolid = true;
+                if (i % 4 == 0) reg.emplace<Velocity2D>(e).velocity = {1.0f, 0.0f};
+            }
+
+            double ms = measureMs([&] { CollisionSystem(reg, dt); }, reps);
+            runner.add("systems", "CollisionSystem tick", count, ms);
+        }
+    }
+}
+
+} // namespace eng::bench
@@ -0,0 +1,77 @@
+#include "Bench.h"
+#include "engine/ecs/Registry.h"
+#include "engine/ecs/Components.h"
+
+namespace eng::bench {
+
+using namespace eng::ecs;
+
+// Escena sintetica: todas las entidades tienen Transform2D, la mitad
+// Velocity2D (intercaladas para que los dense arrays no esten alineados).
+static void populate(Registry& reg, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Entity e = reg.create();
+        auto& t = reg.emplace<Transform2D>(e);
+        t.position = {static_cast<float>(i), 0.0f};
+        if (i % 2 == 0) {
+            reg.emplace<Velocity2D>(e).velocity = {1.0f, 0.5f};
+        }
+    }
+}
+
+void runViewBench(Runner& runner) {
+    constexpr float dt = 1.0f / 60.0f;
+
+    for (size_t count : {10'000u, 100'000u, 1'000'000u}) {
+        Registry reg;
+        populate(reg, count);
+        const size_t moving = reg.componentCount<Velocity2D>();
+
+        // Patron del View anterior: por cada entidad del driver se vuelve
+        // a pasar por reg.has<T>() / reg.get<T>().
+        double msLookup = measureMs([&] {
+            for (auto [e, v] : reg.view<Velocity2D>()) {
+                (void)v;
+                if (!(reg.has<Transform2D>(e) && reg.has<Velocity2D>(e))) continue;
+                auto& t = reg.get<Transform2D>(e);
+                auto& vel = reg.get<Velocity2D>(e);
+                t.prevPosition = t.position;
+                t.position.x += vel.velocity.x * dt;
+                t.position.y += vel.velocity.y * dt;
+            }
+        });
+        runner.add("view", "registry has/get per entity", moving, msLookup);
+
+        double msIter = measureMs([&] {
+            for (auto [e, t, v] : reg.view<Transform2D, Velocity2D>()) {
+                (void)e;
+                t.prevPosition = t.position;
+                t.position.x += v.velocity.x * dt;
+                t.position.y += v.velocity.y * dt;
+            }
+        });
+        runner.add("view", "View iterator (cached pools)", moving, msIter);
+
+        double msEach = measureMs([&] {
+            reg.view<Transform2D, Velocity2D>().each([](Transform2D& t, Velocity2D& v) {
+                t.prevPosition = t.position;
+                t.position.x += v.velocity.x * dt;
+                t.position.y += v.velocity.y * dt;
+            });
+        });
+        runner.add("view", "View::each", moving, msEach);
+
+        // Ultimo: crear el grupo reordena los pools (afectaria a los de arriba).
+        reg.group<Transform2D, Velocity2D>();
+        double msGroup = measureMs([&] {
+            reg.group<Transform2D, Velocity2D>().each([](Transform2D& t, Velocity2D& v) {
+                t.prevPosition = t.position;
+                t.position.x += v.velocity.x * dt;
+                t.position.y += v.velocity.y * dt;
+            });
+        });
+        runner.add("view", "Group::each (owning group)", moving, msGroup);
+    }
+}
+
+} // namespace eng::bench
@@ -0,0 +1,83 @@
+#include "Bench.h"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace eng::bench {
+void runViewBench(Runner& runner);
+void runArchetypeBench(Runner& runner);
+void runMotionBench(Runner& runner);
+void runParallelBench(Runner& runner);
+void runSpawnBench(Runner& runner);
+void runJobBench(Runner& runner);
+void runCoreBench(Runner& runner);
+void runSystemBench(Runner& runner);
+void runRenderBench(Runner& runner);
+}
+
+// ─────────────────────────────────────────────────────────────
+// engine_bench: microbenchmarks del ECS y del submit de render. No abre
+// ventana ni crea contexto GL (el render usa NullRenderBackend); compilar
+// en Release para que los numeros signifiquen algo.
+//
+//   engine_bench [--suite <name>]... [--json <path>|-]
+//
+// --suite corre solo esos suites (core, systems, render, view, storage,
+// motion, parallel, spawn, jobs); --json escribe los resultados como JSON en
+// path ("-" = stdout, en vez de la tabla).
+// ─────────────────────────────────────────────────────────────
+int main(int argc, char** argv) {
+    struct Suite {
+        const char* name;
+        void (*run)(eng::bench::Runner&);
+    };
+    const Suite suites[] = {
+        {"core",     eng::bench::runCoreBench},
+        {"systems",  eng::bench::runSystemBench},
+        {"render",   eng::bench::runRenderBench},
+        {"view",     eng::bench::runViewBench},
+        {"storage",  eng::bench::runArchetypeBench},
+        {"motion",   eng::bench::runMotionBench},
+        {"parallel", eng::bench::runParallelBench},
+        {"spawn",    eng::bench::runSpawnBench},
+        {"jobs",     eng::bench::runJobBench},
+    };
+
+    std::vector<std::string> selected;
+    const char* jsonPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--suite") == 0 && i + 1 < argc) {
+            selected.push_back(argv[++i]);
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--suite <name>]... [--json <path>|-]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    eng::bench::Runner runner;
+    for (const Suite& suite : suites) {
+        if (!selected.empty() && std::find(selected.begin(), selected.end(), suite.name) == selected.end()) continue;
+        suite.run(runner);
+    }
+
+    const bool jsonToStdout = jsonPath && std::strcmp(jsonPath, "-") == 0;
+    if (!jsonToStdout) runner.printTable();
+    if (jsonToStdout) {
+        runner.writeJson(stdout);
+    } else if (jsonPath) {
+        std::FILE* f = std::fopen(jsonPath, "wb");
+        if (!f) {
+            std::fprintf(stderr, "engine_bench: could not write '%s'\n", jsonPath);
+            return 1;
+        }
+        runner.writeJson(f);
+        std::fclose(f);
+    }
+    return 0;
+}
@@ -2,28 +2,75 @@
 #include "engine/ecs/Registry.h"
 #include "engine/ecs/SystemScheduler.h"
 #include "engine/Profiling.h"
+#include "engine/JobSystem.h"
 #include "engine/render/Renderer2D.h"
 #include "engine/render/TextureManager.h"
+#include "engine/render/AnimationLibrary.h"
+#include "engine/render/RenderPipeline.h"
 
 #include <SDL.h>
 
+#include <cstdint>
+#include <memory>
+
 namespace eng {
 
+struct EngineConfig {
+    const char* windowTitle  = "My Engine";
+    int         windowWidth  = 1280;
+    int         windowHeight = 720;
+    bool        vsync        = true;
+
+    /// Sin ventana, contexto GL ni ImGui: solo ECS, scheduler, jobs, Time,
+    /// Input (inyectable con Input::setKey) y profiler. Para servidores
+    /// dedicados, benchmarks y CI. La fase Render no corre y en el
+    /// contexto del registry window/renderer/textures quedan en nullptr.
+    bool headless = false;
+
+    /// Headless: cada frame es exactamente un fixed step, sin mirar el
+    /// reloj (miles de ticks por segundo si la simulacion da). false =
+    /// a velocidad real, durmiendo entre steps (servidor dedicado).
+    bool unthrottled = true;
+
+    /// Render en un thread aparte (ver RenderPipeline): el main thread
+    /// simula el frame N+1 mientras el render thread dibuja el N. Los
+    /// sistemas de Render no cambian (graban en vez de dibujar). Solo con
+    /// ventana; las texturas se tienen que cargar antes de run().
+    bool pipelinedRender = false;
+
+    /// run() termina despues de tantos frames (0 = hasta quit() o hasta
+    /// cerrar la ventana).
+    uint64_t maxFrames = 0;
+};
+
 class Engine {
 public:
-    bool init();
+    bool init(const EngineConfig& config = {});
     void run();
     void shutdown();
 
+    /// Termina run() al final del frame actual.
+    void quit() { m_running = false; }
+
+    const EngineConfig& config() const { return m_config; }
+    bool headless() const { return m_config.headless; }
+
     // ── Getters para que la demo/juego pueda acceder a los subsistemas ──
     SDL_Window*           window()    { return m_window; }
     ecs::Registry&        registry()  { return m_registry; }
     ecs::SystemScheduler& scheduler() { return m_scheduler; }
     Renderer2D&           renderer()  { return m_renderer; }
     TextureManager&       textures()  { return m_texManager; }
+    AnimationLibrary&     animations() { return m_animations; }
     Profiler&             profiler()  { return m_profiler; }
+    JobSystem&            jobs()      { return m_jobs; }
 
 private:
+    bool initWindow();
+    void runFrame();
+    void runHeadlessFrame();
+
+    EngineConfig   m_config;
     bool           m_running   = false;
     SDL_Window*    m_window    = nullptr;
     SDL_GLContext  m_glContext  = nullptr;
@@ -33,6 +80,10 @@ private:
     ecs::Registry        m_registry;
     Renderer2D           m_renderer;
     TextureManager       m_texManager;
+    AnimationLibrary     m_animations;
+    JobSystem            m_jobs;
+
+    std::unique_ptr<RenderPipeline> m_pipeline; // solo durante run() con pipelinedRender
 };
 
 } // namespace eng
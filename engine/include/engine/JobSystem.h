@@ -0,0 +1,130 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace eng {
+
+class JobCounter;
+
+/// Unidad de trabajo del JobSystem: la funcion y el contador que se
+/// decrementa al terminarla (puede ser nullptr).
+struct Job {
+    std::function<void()> fn;
+    JobCounter*           counter = nullptr;
+};
+
+/// Cantidad de jobs pendientes de un grupo. Se incrementa al encolar cada
+/// job asociado y se decrementa cuando termina; done() = llego a 0.
+///
+/// Ademas guarda los jobs que dependen de el (JobSystem::runAfter): se
+/// encolan cuando el contador llega a 0.
+///
+/// No se puede destruir con jobs pendientes (esperarlo con
+/// JobSystem::wait). Se puede reusar una vez que llego a 0.
+class JobCounter {
+public:
+    JobCounter() = default;
+    ~JobCounter();
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool done() const { return m_pending.load(std::memory_order_acquire) == 0; }
+    uint32_t pending() const { return m_pending.load(std::memory_order_acquire); }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> m_pending{0};
+    // Protege m_continuations y la transicion a 0 (el job que termina
+    // ultimo la hace con el mutex tomado; ver ~JobCounter).
+    std::mutex            m_mutex;
+    std::vector<Job>      m_continuations;
+};
+
+/// Job system con work-stealing. Es del Engine y los sistemas lo ven via
+/// reg.ctx().jobs; es la base para paralelizar ECS, render y carga de
+/// assets.
+///
+/// - Cada worker tiene su propia cola: encola y saca del final (LIFO,
+///   lo ultimo que encolo sigue caliente en cache) y, si esta vacia, roba
+///   del principio de la cola de otro (FIFO: los jobs mas viejos, que
+///   suelen ser los mas grandes).
+/// - Los threads que no son workers (el main thread) comparten una cola
+///   extra.
+/// - run(fn, &counter) encola un job; runAfter(dep, fn, &counter) lo
+///   encola recien cuando dep llega a 0.
+/// - wait(counter) no duerme: mientras el contador no llega a 0 ejecuta
+///   otros jobs, asi que esperar desde adentro de un job no bloquea un
+///   worker ni puede trabar el pool.
+///
+/// parallelFor(count, grain, fn) parte [0, count) en chunks de `grain`
+/// elementos y los reparte entre los workers y el thread que llama (que
+/// tambien trabaja). Bloquea hasta que terminan todos los chunks.
+/// fn se llama concurrentemente desde varios threads: tiene que ser
+/// thread-safe para rangos disjuntos. Se puede anidar.
+class JobSystem {
+public:
+    using JobFn   = std::function<void()>;
+    using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+    /// workerCount = threads extra ademas del que llama.
+    /// Por defecto hardware_concurrency() - 1 (0 = todo inline en wait()).
+    explicit JobSystem(unsigned workerCount = defaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned workerCount() const { return static_cast<unsigned>(m_threads.size()); }
+
+    /// Encola fn. Si counter no es nullptr se incrementa ya y se
+    /// decrementa cuando fn termina.
+    void run(JobFn fn, JobCounter* counter = nullptr);
+
+    /// Encola fn cuando dependency llegue a 0 (ya, si ya esta en 0).
+    /// counter se incrementa ya: esperarlo cubre tambien a este job.
+    void runAfter(JobCounter& dependency, JobFn fn, JobCounter* counter = nullptr);
+
+    /// Ejecuta jobs hasta que counter llega a 0.
+    void wait(const JobCounter& counter);
+
+    void parallelFor(size_t count, size_t grain, const RangeFn& fn);
+
+    static unsigned defaultWorkerCount();
+
+private:
+    // Una cola por worker + [0] para los threads externos. alignas para
+    // que los mutex de colas vecinas no compartan linea de cache.
+    struct alignas(64) Queue {
+        std::mutex      mutex;
+        std::deque<Job> jobs;
+    };
+
+    void workerLoop(unsigned queueIndex);
+    void push(Job job);
+    bool tryPop(unsigned queueIndex, Job& out);
+    void execute(Job& job);
+    void finish(JobCounter& counter);
+    unsigned currentQueue() const;
+
+    std::vector<std::thread>              m_threads;
+    std::vector<std::unique_ptr<Queue>>   m_queues;
+
+    // Jobs encolados y todavia no tomados: los workers duermen cuando es 0.
+    std::atomic<uint32_t>   m_queued{0};
+    std::atomic<uint32_t>   m_sleepers{0};
+    std::mutex              m_sleepMutex;
+    std::condition_variable m_wakeCv;
+    std::atomic<bool>       m_stop{false};
+};
+
+} // namespace eng
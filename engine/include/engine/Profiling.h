@@ -1,10 +1,15 @@
 #pragma once
 #include <SDL.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <unordered_map>
-#include <deque>
-#include <numeric>
-#include <algorithm>
+#include <string_view>
+#include <vector>
 
 namespace eng {
 
@@ -16,99 +21,262 @@ struct ProfileStats {
     size_t samples = 0;
 };
 
+/// Profiler por zonas (sistemas, playback de comandos, render thread...).
+///
+/// - Cada zona se registra una vez (registerZone) y queda con un ZoneId
+///   entero; el hot path (submit, ScopeTimer) no usa strings.
+/// - Las zonas se anidan: un ScopeTimer abierto adentro de otro (en el
+///   mismo thread) queda como hijo, y parent() lo expone para mostrar el
+///   arbol. Un sample suelto (submit) cuelga de la zona abierta.
+/// - El anidamiento es por thread: un job que corre en un worker no hereda
+///   la zona abierta en el thread que lo lanzo.
+/// - Contadores (registerCounter/submitCounter): zonas cuyos samples son
+///   valores por frame (draw calls, bytes...) en vez de ms. Mismas stats
+///   sobre la ventana; en las capturas salen como tracks de contador.
+/// - submit() se puede llamar desde cualquier thread sin locks ni
+///   allocations: el sample va a una cola circular MPSC de capacidad fija
+///   (si se llena se descarta y se cuenta en dropped()).
+/// - collect() (lo llama beginFrame, en el main thread) vacia la cola y
+///   actualiza las stats de cada zona en O(1) por sample: ring de los
+///   ultimos `window` samples, suma corrida para el promedio y colas
+///   monotonicas para min/max.
+/// - stats(), zoneCount(), setWindow(), collect() y las capturas son del
+///   main thread.
+/// - captureTrace(frames, path) graba los proximos N frames (cada
+///   ScopeTimer con su thread, inicio y duracion) y los escribe como JSON
+///   de Chrome Trace Event: se abre en Perfetto o chrome://tracing.
+///
+/// Pensado para dejarlo prendido tambien en release.
 class Profiler {
 public:
-    explicit Profiler(size_t window = 120)
-        : m_window(window) {}
+    using ZoneId = uint32_t;
+    static constexpr ZoneId InvalidZone = ~ZoneId{0};
+    static constexpr size_t MaxZones = 256;
+    static constexpr size_t QueueCapacity = 4096; // potencia de 2
 
-    void beginFrame() {
-        m_frameSubmitted.clear();
-    }
+    /// window = samples por zona para las stats; maxWindow = lo maximo que
+    /// se le puede pedir despues a setWindow() (tamano fijo de los rings).
+    explicit Profiler(size_t window = 120, size_t maxWindow = 600);
+    ~Profiler();
 
-    void submitSample(const std::string& name, double ms) {
-        m_frameSubmitted[name] = ms;
-
-        auto& dq = m_history[name];
-        dq.push_back(ms);
-        if (dq.size() > m_window) dq.pop_front();
-
-        // actualizar stats cacheados
-        ProfileStats st;
-        st.lastMs = ms;
-        st.samples = dq.size();
-        st.avgMs = average(dq);
-        auto [mn, mx] = minmax(dq);
-        st.minMs = mn;
-        st.maxMs = mx;
-        m_stats[name] = st;
-    }
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
 
-    // Estadísticas por sistema (promedio móvil)
-    const std::unordered_map<std::string, ProfileStats>& stats() const {
-        return m_stats;
-    }
+    /// Id de la zona `name` (la crea la primera vez). Thread-safe; toma un
+    /// mutex y puede alocar: llamarlo al registrar, no por sample.
+    ZoneId registerZone(std::string_view name);
+    /// Igual que registerZone pero para un contador. Un nombre es zona o
+    /// contador segun como se registro la primera vez.
+    ZoneId registerCounter(std::string_view name);
 
-    // Último frame (si lo querés mostrar)
-    const std::unordered_map<std::string, double>& lastFrameSamples() const {
-        return m_frameSubmitted;
-    }
+    /// Registra un sample de ms para la zona. Lock-free, sin allocations.
+    /// No tiene inicio, asi que entra en las stats pero no en las capturas.
+    void submit(ZoneId zone, double ms);
+    /// Registra el valor de un contador (con el instante actual, para las
+    /// capturas). Lock-free, sin allocations.
+    void submitCounter(ZoneId counter, double value);
 
-    void setWindow(size_t window) {
-        m_window = std::max<size_t>(1, window);
-        // opcional: recortar colas actuales
-        for (auto& kv : m_history) {
-            auto& dq = kv.second;
-            while (dq.size() > m_window) dq.pop_front();
-        }
-        // stats se recalculan al próximo submit
+    /// Ticks de SDL_GetPerformanceCounter -> ms (para medir a mano tramos
+    /// que se repiten mucho y mandarlos sumados con submit).
+    static double ticksToMs(uint64_t ticks) {
+        return static_cast<double>(ticks) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
     }
 
+    /// collect() + marca de frame para la captura en curso.
+    void beginFrame();
+
+    /// Aplica los samples pendientes a las stats (main thread).
+    void collect();
+
+    size_t zoneCount() const { return m_zoneCount.load(std::memory_order_acquire); }
+    /// Numero unico de esta instancia (empieza en 1, no se reusa aunque se
+    /// reuse la direccion): clave de los caches de ProfileZone.
+    uint32_t serial() const { return m_serial; }
+    const std::string& zoneName(ZoneId zone) const { return m_zones[zone]->name; }
+    const ProfileStats& stats(ZoneId zone) const { return m_zones[zone]->stats; }
+    /// Primera zona que la tuvo abierta (InvalidZone = raiz).
+    ZoneId parent(ZoneId zone) const { return m_zones[zone]->parent; }
+    /// true si se registro con registerCounter (las stats no son ms).
+    bool isCounter(ZoneId zone) const { return m_zones[zone]->counter; }
+
+    /// Samples descartados porque la cola estaba llena.
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    /// Cambia la ventana (1..maxWindow) y recalcula las stats con los
+    /// samples que ya estan en los rings.
+    void setWindow(size_t window);
     size_t window() const { return m_window; }
+    size_t maxWindow() const { return m_maxWindow; }
 
-private:
-    static double average(const std::deque<double>& dq) {
-        if (dq.empty()) return 0.0;
-        double sum = 0.0;
-        for (double v : dq) sum += v;
-        return sum / static_cast<double>(dq.size());
-    }
+    /// Graba los proximos `frames` frames (desde el proximo beginFrame) y
+    /// los escribe en `path` al terminar. Pisa una captura pendiente.
+    void captureTrace(size_t frames, std::string path);
+    /// Escribe ya lo que se lleva grabado de la captura en curso (p.ej. al
+    /// salir del loop antes de completar los frames).
+    void finishTrace();
+    bool capturing() const { return m_traceFramesLeft > 0 || m_traceRequest > 0; }
+    size_t traceFramesLeft() const { return m_traceFramesLeft; }
+    /// Path de la ultima captura escrita ("" si no hubo o fallo).
+    const std::string& lastTrace() const { return m_lastTrace; }
 
-    static std::pair<double, double> minmax(const std::deque<double>& dq) {
-        if (dq.empty()) return {0.0, 0.0};
-        auto mm = std::minmax_element(dq.begin(), dq.end());
-        return { *mm.first, *mm.second };
-    }
+    /// Nombre del thread que llama en las capturas (Main, Render, Worker N...).
+    /// Global, no por Profiler. Toma un mutex: llamarlo al crear el thread.
+    static void setThreadName(std::string_view name);
 
 private:
+    friend class ScopeTimer;
+
+    // Zona abierta (el ScopeTimer mas interno) del thread actual.
+    static inline thread_local ZoneId t_openZone = InvalidZone;
+
+    /// Cola monotonica sobre un ring de capacidad fija: el frente es el
+    /// min (o max) de la ventana. Cada sample entra y sale una sola vez,
+    /// asi que es O(1) amortizado.
+    struct MonotonicQueue {
+        struct Entry {
+            uint64_t index;
+            double   value;
+        };
+        std::unique_ptr<Entry[]> entries;
+        size_t capacity = 0;
+        size_t head = 0;
+        size_t size = 0;
+
+        void reset(size_t cap);
+        void clear() { head = size = 0; }
+        // keepBack(back, v) = true si back sigue siendo candidato con v detras.
+        template <typename KeepBack>
+        void push(uint64_t index, double value, uint64_t window, KeepBack keepBack);
+        double front() const { return entries[head].value; }
+    };
+
+    struct Zone {
+        std::string name;
+        std::unique_ptr<double[]> ring; // ultimos maxWindow samples
+        uint64_t count = 0;             // samples totales recibidos
+        double sum = 0.0;               // suma de los ultimos min(count, window)
+        ZoneId parent = InvalidZone;
+        bool counter = false;
+        MonotonicQueue minQueue;
+        MonotonicQueue maxQueue;
+        ProfileStats stats;
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> sequence{0};
+        ZoneId   zone = 0;
+        ZoneId   parent = InvalidZone;
+        uint32_t thread = 0;
+        uint64_t start = 0; // ticks de SDL_GetPerformanceCounter (0 = sin inicio)
+        double   ms = 0.0;  // o el valor, si la zona es un contador
+    };
+
+    struct TraceEvent {
+        ZoneId   zone;
+        uint32_t thread;
+        uint64_t start;
+        double   ms;
+    };
+
+    ZoneId registerZone(std::string_view name, bool counter);
+    void push(ZoneId zone, ZoneId parent, uint64_t start, double ms);
+    void apply(Zone& zone, ZoneId parent, double ms);
+    void rebuild(Zone& zone);
+    void writeTrace(uint64_t end);
+
+    const uint32_t m_serial;
     size_t m_window;
+    size_t m_maxWindow;
+
+    std::array<std::unique_ptr<Zone>, MaxZones> m_zones;
+    std::atomic<size_t> m_zoneCount{0};
+    std::mutex m_registerMutex;
+
+    // Cola MPSC acotada (Vyukov): cada slot lleva un numero de secuencia
+    // que dice si esta libre para la posicion que lo quiere escribir o
+    // listo para la que lo quiere leer.
+    std::unique_ptr<Slot[]> m_queue;
+    alignas(64) std::atomic<uint64_t> m_enqueuePos{0};
+    alignas(64) uint64_t m_dequeuePos = 0; // solo collect()
+    std::atomic<uint64_t> m_dropped{0};
+
+    // Captura (main thread). m_traceRequest arranca en el proximo
+    // beginFrame; los eventos anteriores a m_traceStart se ignoran.
+    size_t m_traceRequest = 0;
+    std::string m_traceRequestPath;
+    size_t m_traceFramesLeft = 0;
+    uint64_t m_traceStart = 0;
+    std::string m_tracePath;
+    std::vector<TraceEvent> m_traceEvents;
+    std::vector<uint64_t> m_traceFrames; // inicio de cada frame grabado
+    std::string m_lastTrace;
+};
 
-    // último frame
-    std::unordered_map<std::string, double> m_frameSubmitted;
+/// Zona declarada donde se usa, sin registrarla a mano:
+///
+///   static eng::ProfileZone s_zone("Collision/BuildGrid");
+///   eng::ScopeTimer t(ctx.profiler, s_zone);
+///
+/// Se registra en el primer uso con cada Profiler (despues es una carga
+/// atomica). Thread-safe: si dos threads la registran a la vez, los dos
+/// obtienen el mismo id. El cache guarda el par (serial del Profiler, id)
+/// en un solo atomico: con dos Profilers, o uno nuevo en la direccion de
+/// uno destruido, nunca se lee el id de otro (a lo sumo se re-registra).
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) : m_name(name) {}
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
 
-    // historial por sistema
-    std::unordered_map<std::string, std::deque<double>> m_history;
+    Profiler::ZoneId id(Profiler& profiler) {
+        const uint64_t cached = m_cached.load(std::memory_order_acquire);
+        if (static_cast<uint32_t>(cached >> 32) == profiler.serial()) {
+            return static_cast<Profiler::ZoneId>(cached);
+        }
+        const Profiler::ZoneId zone = profiler.registerZone(m_name);
+        m_cached.store((uint64_t{profiler.serial()} << 32) | zone, std::memory_order_release);
+        return zone;
+    }
 
-    // stats precomputados por sistema
-    std::unordered_map<std::string, ProfileStats> m_stats;
+private:
+    const char* m_name;
+    std::atomic<uint64_t> m_cached{0}; // (serial << 32) | id; serial 0 = ninguno
 };
 
+/// Mide el scope como sample de `zone` y la deja abierta mientras tanto
+/// (los ScopeTimer de adentro quedan como hijos). Con profiler nullptr
+/// (p.ej. sistemas corridos desde un bench sin Engine) no hace nada.
 class ScopeTimer {
 public:
-    ScopeTimer(Profiler& profiler, std::string name)
-        : m_profiler(profiler), m_name(std::move(name)) {
+    ScopeTimer(Profiler& profiler, Profiler::ZoneId zone)
+        : ScopeTimer(&profiler, zone) {}
+
+    ScopeTimer(Profiler* profiler, ProfileZone& zone)
+        : ScopeTimer(profiler, profiler ? zone.id(*profiler) : Profiler::InvalidZone) {}
+
+    ScopeTimer(Profiler* profiler, Profiler::ZoneId zone)
+        : m_profiler(zone != Profiler::InvalidZone ? profiler : nullptr), m_zone(zone) {
+        if (!m_profiler) return;
+        m_parent = Profiler::t_openZone;
+        Profiler::t_openZone = m_zone;
         m_start = SDL_GetPerformanceCounter();
     }
 
     ~ScopeTimer() {
-        const uint64_t end = SDL_GetPerformanceCounter();
-        const double freq = static_cast<double>(SDL_GetPerformanceFrequency());
-        const double ms = (static_cast<double>(end - m_start) / freq) * 1000.0;
-        m_profiler.submitSample(m_name, ms);
+        if (!m_profiler) return;
+        const double ms = Profiler::ticksToMs(SDL_GetPerformanceCounter() - m_start);
+        Profiler::t_openZone = m_parent;
+        m_profiler->push(m_zone, m_parent, m_start, ms);
     }
 
+    ScopeTimer(const ScopeTimer&) = delete;
+    ScopeTimer& operator=(const ScopeTimer&) = delete;
+
 private:
-    Profiler& m_profiler;
-    std::string m_name;
+    Profiler* m_profiler;
+    Profiler::ZoneId m_zone;
+    Profiler::ZoneId m_parent = Profiler::InvalidZone;
     uint64_t m_start = 0;
 };
 
@@ -6,6 +6,9 @@ class Time {
 public:
     static void init();
     static void beginFrame();
+    /// Frame de duracion dt sin mirar el reloj (Engine headless sin
+    /// throttle: la simulacion avanza tan rapido como se pueda).
+    static void beginFrame(float dt);
 
     static float deltaTime();
     static float fixedDeltaTime();
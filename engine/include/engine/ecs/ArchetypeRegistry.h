@@ -0,0 +1,317 @@
+#pragma once
+#include "engine/ecs/Entity.h"
+#include "engine/ecs/ComponentType.h"
+
+#include <vector>
+#include <array>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+#include <type_traits>
+
+namespace eng::ecs {
+
+// ────────────────────────────────────────────────────────────────
+// Backend alternativo de almacenamiento: archetypes + chunks
+// ────────────────────────────────────────────────────────────────
+//
+// Registry (sparse-set) guarda un pool por tipo de componente y una query
+// de N componentes paga un lookup de sparse por cada componente extra.
+// ArchetypeRegistry agrupa a las entidades por SET de componentes
+// (archetype) y las guarda en chunks de 16 KB con una columna SoA por
+// componente: una query recorre los chunks que matchean linealmente, con
+// todos los componentes de la fila i en la posicion i de cada columna.
+//
+// El costo se mueve a los cambios estructurales: agregar o quitar un
+// componente mueve la entidad de archetype (copia todas sus columnas).
+//
+// Se elige POR REGISTRY: la API (create/destroy/emplace/remove/has/get/
+// view().each) es la misma que la de Registry, asi que codigo templateado
+// sobre el tipo de registry (ej: engine_bench) corre igual con ambos.
+// Los sistemas del engine siguen usando Registry (groups, ctx, etc.).
+
+/// Info type-erased de un componente: lo minimo para mover y destruir
+/// valores dentro de las columnas de un chunk sin conocer T.
+struct ComponentInfo {
+    ComponentTypeId id = 0;
+    size_t size = 0;     // 0 = tipo vacio (tag): columna sin almacenamiento
+    size_t align = 1;
+    void (*moveConstruct)(void* dst, void* src) = nullptr; // new (dst) T(std::move(*src))
+    void (*destroy)(void* p) = nullptr;                     // p->~T()
+};
+
+template <typename T>
+const ComponentInfo& componentInfo() {
+    static const ComponentInfo s_info{
+        componentTypeId<T>(),
+        std::is_empty_v<T> ? 0 : sizeof(T),
+        alignof(T),
+        [](void* dst, void* src) { new (dst) T(std::move(*static_cast<T*>(src))); },
+        [](void* p) { static_cast<T*>(p)->~T(); }
+    };
+    return s_info;
+}
+
+/// Bloque de memoria fijo donde viven las filas de un archetype.
+/// Layout: [Entity x capacity][col 0 x capacity][col 1 x capacity]...
+struct ArchetypeChunk {
+    static constexpr size_t Bytes = 16 * 1024;
+    static constexpr size_t MaxAlign = 64;
+
+    alignas(MaxAlign) std::byte data[Bytes];
+    uint32_t count = 0;
+};
+
+/// Set de componentes + sus chunks. Todos los chunks estan llenos salvo
+/// el ultimo (el swap-remove siempre rellena con la ultima fila).
+class Archetype {
+public:
+    /// infos ordenados por id, sin repetidos.
+    explicit Archetype(std::vector<const ComponentInfo*> infos);
+
+    const std::vector<ComponentTypeId>& types() const { return m_types; }
+
+    /// Columna del tipo id en este archetype, o -1 si no lo tiene.
+    int column(ComponentTypeId id) const {
+        return id < m_columnByType.size() ? m_columnByType[id] : -1;
+    }
+
+    uint32_t capacity() const { return m_capacity; }
+    size_t size() const { return m_count; }
+    size_t chunkCount() const { return m_chunks.size(); }
+    ArchetypeChunk& chunk(size_t i) { return *m_chunks[i]; }
+
+    Entity* entities(ArchetypeChunk& c) {
+        return reinterpret_cast<Entity*>(c.data);
+    }
+
+    void* columnData(ArchetypeChunk& c, int col) {
+        return c.data + m_offsets[static_cast<size_t>(col)];
+    }
+
+    template <typename T>
+    T* column(ArchetypeChunk& c, int col) {
+        return std::launder(reinterpret_cast<T*>(columnData(c, col)));
+    }
+
+private:
+    friend class ArchetypeRegistry;
+
+    std::vector<const ComponentInfo*> m_infos;  // por columna
+    std::vector<ComponentTypeId>      m_types;  // por columna (ordenados)
+    std::vector<int32_t>              m_columnByType; // [typeId] -> columna o -1
+    std::vector<size_t>               m_offsets;      // offset de cada columna en el chunk
+    uint32_t m_capacity = 0;
+    size_t   m_count = 0;
+
+    std::vector<std::unique_ptr<ArchetypeChunk>> m_chunks;
+
+    // Grafo de archetypes: cache de "este + T" y "este - T" por typeId.
+    std::vector<Archetype*> m_addEdge;
+    std::vector<Archetype*> m_removeEdge;
+};
+
+class ArchetypeRegistry {
+public:
+    ArchetypeRegistry();
+    ~ArchetypeRegistry();
+
+    ArchetypeRegistry(const ArchetypeRegistry&) = delete;
+    ArchetypeRegistry& operator=(const ArchetypeRegistry&) = delete;
+
+    Entity create();
+    void destroy(Entity e);
+
+    bool isAlive(Entity e) const;
+
+    size_t aliveCount() const { return m_aliveCount; }
+
+    template <typename T>
+    bool has(Entity e) const {
+        if (!isAlive(e)) return false;
+        return m_slots[e.index].loc.archetype->column(componentTypeId<T>()) >= 0;
+    }
+
+    template <typename T>
+    T& get(Entity e) {
+        assert(has<T>(e));
+        const Location& loc = m_slots[e.index].loc;
+        return componentAt<T>(loc, loc.archetype->column(componentTypeId<T>()));
+    }
+
+    template <typename T, typename... Args>
+    T& emplace(Entity e, Args&&... args) {
+        assert(isAlive(e));
+        const ComponentInfo& info = componentInfo<T>();
+
+        Location& loc = m_slots[e.index].loc;
+        int col = loc.archetype->column(info.id);
+        if (col >= 0) {
+            // si ya existe, lo reasignamos
+            T& existing = componentAt<T>(loc, col);
+            existing = T(std::forward<Args>(args)...);
+            return existing;
+        }
+
+        // Mover la entidad al archetype "actual + T". La columna de T queda
+        // sin construir y la construimos aca con placement new.
+        if constexpr (std::is_empty_v<T>) {
+            moveToArchetype(e, addEdge(loc.archetype, info));
+            return componentAt<T>(loc, loc.archetype->column(info.id));
+        } else {
+            // T se construye ANTES de mover: args puede apuntar a componentes
+            // del chunk de origen (de e o de otra entidad, p.ej.
+            // get<Transform2D>(other).position), y moveToArchetype reubica la
+            // fila de e y hace swap-remove de la ultima.
+            T value(std::forward<Args>(args)...);
+            moveToArchetype(e, addEdge(loc.archetype, info));
+            col = loc.archetype->column(info.id);
+            void* p = loc.archetype->columnData(chunkOf(loc), col);
+            return *new (static_cast<T*>(p) + loc.row) T(std::move(value));
+        }
+    }
+
+    template <typename T>
+    void remove(Entity e) {
+        if (!has<T>(e)) return;
+        const Location& loc = m_slots[e.index].loc;
+        moveToArchetype(e, removeEdge(loc.archetype, componentTypeId<T>()));
+    }
+
+    template <typename T>
+    size_t componentCount() const {
+        const ComponentTypeId id = componentTypeId<T>();
+        size_t n = 0;
+        for (const auto& a : m_archetypes) {
+            if (a->column(id) >= 0) n += a->size();
+        }
+        return n;
+    }
+
+    void clear();
+
+    size_t archetypeCount() const { return m_archetypes.size(); }
+    size_t chunkCount() const;
+
+    /// Query: recorre todos los archetypes que contienen Ts y, dentro de
+    /// cada uno, sus chunks de forma lineal. Misma forma que
+    /// Registry::View::each: fn(Entity, Ts&...) o fn(Ts&...).
+    /// No hacer cambios estructurales dentro de fn.
+    template <typename... Ts>
+    class View {
+        static_assert(sizeof...(Ts) > 0, "View needs at least one component type.");
+
+    public:
+        explicit View(ArchetypeRegistry& reg) : m_reg(reg) {}
+
+        template <typename Fn>
+        void each(Fn&& fn) const {
+            eachImpl(fn, std::index_sequence_for<Ts...>{});
+        }
+
+    private:
+        template <typename Fn, size_t... Is>
+        void eachImpl(Fn& fn, std::index_sequence<Is...>) const {
+            const std::array<ComponentTypeId, sizeof...(Ts)> ids{componentTypeId<Ts>()...};
+
+            for (const auto& archetype : m_reg.m_archetypes) {
+                Archetype& a = *archetype;
+                if (a.size() == 0) continue;
+
+                std::array<int, sizeof...(Ts)> cols{};
+                bool match = true;
+                for (size_t k = 0; k < ids.size() && match; ++k) {
+                    cols[k] = a.column(ids[k]);
+                    match = cols[k] >= 0;
+                }
+                if (!match) continue;
+
+                for (size_t c = 0; c < a.chunkCount(); ++c) {
+                    ArchetypeChunk& chunk = a.chunk(c);
+                    const Entity* entities = a.entities(chunk);
+                    auto columns = std::make_tuple(a.template column<Ts>(chunk, cols[Is])...);
+
+                    const uint32_t n = chunk.count;
+                    for (uint32_t i = 0; i < n; ++i) {
+                        if constexpr (std::is_invocable_v<Fn&, Entity, Ts&...>) {
+                            fn(entities[i], at<Ts>(std::get<Is>(columns), i)...);
+                        } else {
+                            static_assert(std::is_invocable_v<Fn&, Ts&...>,
+                                "ArchetypeRegistry::View::each expects fn(Entity, Ts&...) or fn(Ts&...).");
+                            fn(at<Ts>(std::get<Is>(columns), i)...);
+                        }
+                    }
+                }
+            }
+        }
+
+        ArchetypeRegistry& m_reg;
+    };
+
+    template <typename... Ts>
+    View<Ts...> view() {
+        return View<Ts...>(*this);
+    }
+
+private:
+    struct Location {
+        Archetype* archetype = nullptr;
+        uint32_t   chunk = 0;
+        uint32_t   row = 0;
+    };
+
+    struct Slot {
+        uint32_t generation = 0;
+        bool alive = false;
+        Location loc;
+    };
+
+    /// Los tipos vacios (tags) no tienen almacenamiento: todas las
+    /// entidades comparten la misma instancia estatica.
+    template <typename T>
+    static T& at(T* column, uint32_t row) {
+        if constexpr (std::is_empty_v<T>) {
+            (void)column; (void)row;
+            static T s_instance{};
+            return s_instance;
+        } else {
+            return column[row];
+        }
+    }
+
+    template <typename T>
+    T& componentAt(const Location& loc, int col) {
+        return at<T>(loc.archetype->column<T>(chunkOf(loc), col), loc.row);
+    }
+
+    ArchetypeChunk& chunkOf(const Location& loc) {
+        return loc.archetype->chunk(loc.chunk);
+    }
+
+    void* cell(const Location& loc, size_t col);
+
+    Archetype* archetypeFor(std::vector<const ComponentInfo*> infos);
+    Archetype* addEdge(Archetype* from, const ComponentInfo& info);
+    Archetype* removeEdge(Archetype* from, ComponentTypeId id);
+
+    Location allocRow(Archetype& a, Entity e);
+    void     removeRow(const Location& hole);
+    void     moveToArchetype(Entity e, Archetype* dst);
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_freeList;
+    size_t m_aliveCount = 0;
+
+    std::vector<std::unique_ptr<Archetype>> m_archetypes;
+    std::map<std::vector<ComponentTypeId>, Archetype*> m_archetypeIndex;
+    Archetype* m_root = nullptr; // archetype sin componentes
+
+    std::vector<std::unique_ptr<ArchetypeChunk>> m_freeChunks; // chunks vacios para reusar
+};
+
+} // namespace eng::ecs
@@ -0,0 +1,208 @@
+#pragma once
+#include "engine/ecs/Entity.h"
+#include "engine/ecs/ComponentType.h"
+#include "engine/ecs/Registry.h"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+
+namespace eng::ecs {
+
+/// Graba cambios estructurales (create/destroy/emplace/remove) para
+/// aplicarlos despues, cuando nadie esta iterando. Es la forma segura de
+/// spawnear/despawnear desde adentro de un View/Group::each o de un
+/// parallelEach.
+///
+///   auto& cmd = reg.ctx().scheduler->commandBuffer();
+///   reg.view<Health>().each([&](Entity e, Health& h) {
+///       if (h.value <= 0) cmd.destroy(e);
+///   });
+///   Entity p = cmd.create();               // handle temporal
+///   cmd.emplace<Transform2D>(p);           // valido dentro del mismo buffer
+///
+/// create() devuelve un handle TEMPORAL: solo sirve para grabar mas
+/// comandos en este mismo buffer y deja de valer en el playback.
+///
+/// Playback (en lote y ordenado, no en orden de grabacion):
+///   1. creates: todas las entidades nuevas con un solo create(span)
+///   2. emplaces: agrupados por tipo de componente (un reserve por tipo) y
+///      dentro de cada tipo ordenados por indice de entidad
+///   3. removes: ordenados por (tipo, indice de entidad)
+///   4. destroys: ordenados por indice, sin repetidos
+/// Consecuencia: dentro de un mismo buffer remove gana sobre emplace y
+/// destroy gana sobre todo. Comandos sobre entidades que ya no estan vivas
+/// al momento del playback se ignoran.
+class CommandBuffer {
+public:
+    /// Los handles temporales tienen este bit prendido en generation (el
+    /// resto de generation es el id del buffer que los creo).
+    static constexpr uint32_t TempBit = 0x80000000u;
+
+    explicit CommandBuffer(uint32_t id = 0) : m_id(id) {
+        assert((id & TempBit) == 0);
+    }
+
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    static bool isTemp(Entity e) { return (e.generation & TempBit) != 0; }
+
+    /// Graba la creacion de una entidad y devuelve su handle temporal.
+    Entity create() {
+        return Entity{ m_tempCount++, TempBit | m_id };
+    }
+
+    void destroy(Entity e) {
+        checkHandle(e);
+        m_destroys.push_back(e);
+    }
+
+    template <typename T, typename... Args>
+    void emplace(Entity e, Args&&... args) {
+        checkHandle(e);
+        auto& list = emplaceList<T>();
+        list.entities.push_back(e);
+        list.values.emplace_back(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    void remove(Entity e) {
+        checkHandle(e);
+        m_removes.push_back(RemoveOp{
+            componentTypeId<T>(), e,
+            [](Registry& reg, Entity target) { reg.remove<T>(target); } });
+    }
+
+    bool empty() const {
+        return m_tempCount == 0 && m_destroys.empty() && m_removes.empty() && m_emplaceTypes.empty();
+    }
+
+    /// Aplica todos los comandos a reg y deja el buffer vacio.
+    /// No llamar mientras se itera reg.
+    void playback(Registry& reg);
+
+private:
+    friend class CommandQueue;
+
+    struct IEmplaceList {
+        virtual ~IEmplaceList() = default;
+        virtual void apply(Registry& reg, const CommandBuffer& cmd) = 0;
+        virtual void clear() = 0;
+    };
+
+    template <typename T>
+    struct EmplaceList final : IEmplaceList {
+        std::vector<Entity> entities;
+        std::vector<T>      values;
+
+        void apply(Registry& reg, const CommandBuffer& cmd) override {
+            // Orden estable por indice de entidad: acceso al sparse en orden
+            // y, si una entidad recibio T dos veces, gana la ultima grabada.
+            std::vector<Entity> resolved(entities.size());
+            for (size_t i = 0; i < entities.size(); ++i) resolved[i] = cmd.resolve(entities[i]);
+
+            std::vector<uint32_t> order(entities.size());
+            std::iota(order.begin(), order.end(), 0u);
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+                return resolved[a].index < resolved[b].index;
+            });
+
+            reg.reserve<T>(reg.componentCount<T>() + entities.size());
+            for (uint32_t i : order) {
+                if (reg.isAlive(resolved[i])) {
+                    reg.emplace<T>(resolved[i], std::move(values[i]));
+                }
+            }
+        }
+
+        void clear() override {
+            entities.clear();
+            values.clear();
+        }
+    };
+
+    struct RemoveOp {
+        ComponentTypeId id;
+        Entity e;
+        void (*apply)(Registry&, Entity);
+    };
+
+    template <typename T>
+    EmplaceList<T>& emplaceList() {
+        const ComponentTypeId id = componentTypeId<T>();
+        if (id >= m_emplaces.size()) m_emplaces.resize(id + 1);
+        auto& slot = m_emplaces[id];
+        if (!slot) slot = std::make_unique<EmplaceList<T>>();
+        auto& list = static_cast<EmplaceList<T>&>(*slot);
+        if (list.entities.empty()) m_emplaceTypes.push_back(id);
+        return list;
+    }
+
+    void checkHandle(Entity e) const {
+        (void)e;
+        assert((!isTemp(e) || ((e.generation & ~TempBit) == m_id && e.index < m_tempCount)) &&
+               "Temporary entity handle from another CommandBuffer!");
+    }
+
+    /// Handle grabado -> entidad real (los temporales, despues de resolveCreates).
+    Entity resolve(Entity e) const {
+        return isTemp(e) ? m_created[e.index] : e;
+    }
+
+    // Pasos del playback (CommandQueue los intercala entre varios buffers).
+    void resolveCreates(Registry& reg);
+    void applyEmplaces(Registry& reg);
+    void applyRemoves(Registry& reg);
+    void appendDestroys(std::vector<Entity>& out) const;
+    void reset();
+
+    static void destroySorted(Registry& reg, std::vector<Entity>& entities);
+
+    uint32_t m_id = 0;
+    uint32_t m_tempCount = 0;
+    std::vector<Entity> m_created; // [temp index] -> entidad real
+
+    std::vector<std::unique_ptr<IEmplaceList>> m_emplaces; // [ComponentTypeId]
+    std::vector<ComponentTypeId> m_emplaceTypes;           // tipos con emplaces pendientes
+    std::vector<RemoveOp> m_removes;
+    std::vector<Entity>   m_destroys;
+};
+
+/// Un CommandBuffer por thread: los sistemas que corren en paralelo (o
+/// adentro de un parallelEach) graban sin locks en el buffer de su thread.
+/// Solo el primer acceso de cada thread a la cola toma un mutex.
+///
+/// La cola del SystemScheduler se reproduce al final de cada runPhase.
+/// El orden entre buffers de distintos threads no esta definido; cada paso
+/// del playback (creates, emplaces, removes, destroys) se completa en TODOS
+/// los buffers antes de pasar al siguiente.
+class CommandQueue {
+public:
+    CommandQueue();
+
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    /// Buffer del thread actual (lo crea la primera vez).
+    CommandBuffer& local();
+
+    bool empty() const;
+
+    /// Aplica y vacia todos los buffers. No llamar mientras algun thread
+    /// esta grabando.
+    void playback(Registry& reg);
+
+private:
+    uint64_t m_queueId; // clave del cache thread_local (nunca se reusa)
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<CommandBuffer>> m_buffers;
+};
+
+} // namespace eng::ecs
@@ -1,7 +1,13 @@
 #pragma once
 #include "engine/ecs/Entity.h"
+#include "engine/ecs/ComponentStorage.h"
 
 #include <vector>
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 #include <utility>
@@ -9,12 +15,68 @@
 
 namespace eng::ecs {
 
+/// Algoritmo para ComponentPool::sort / Registry::sort.
+/// Insertion: O(n) si el pool ya esta casi ordenado (el caso tipico de
+/// reordenar cuadro a cuadro). Std: std::sort + permutacion, O(n log n)
+/// siempre; para el primer orden o datos muy desordenados.
+enum class SortAlgorithm { Insertion, Std };
+
+namespace detail {
+
+/// "Array" de componentes para tipos vacios (tags): no guarda nada y
+/// cualquier indice devuelve la misma instancia compartida. Un tipo vacio
+/// no tiene estado, asi que no hay nada que distinguir entre entidades.
+template <typename T>
+struct EmptyComponentArray {
+    T& operator[](size_t) const { return s_instance; }
+    // Por valor: Group::each indexa lo que devuelve data() como un puntero.
+    EmptyComponentArray data() const { return {}; }
+
+    static inline T s_instance{};
+};
+
+/// Tick con el que marca sus escrituras el sistema que corre en este
+/// thread (Registry::SystemRunScope). source es el tick global del
+/// registry al que aplica: con otro registry, o fuera de un sistema
+/// (playback de comandos), los pools usan el tick global. Con el
+/// scheduler paralelo varios sistemas avanzan el tick global a la vez, asi
+/// que leerlo al escribir daria ticks mas nuevos que el lastRunTick del
+/// sistema (y sus filtros changed<T>() verian sus propias escrituras).
+struct WriteTick {
+    const std::atomic<uint32_t>* source = nullptr;
+    uint32_t tick = 0;
+};
+
+inline thread_local WriteTick t_writeTick;
+
+/// Instala un WriteTick para el thread actual mientras vive (anidable).
+class WriteTickScope {
+public:
+    explicit WriteTickScope(WriteTick tick) : m_prev(t_writeTick) { t_writeTick = tick; }
+    ~WriteTickScope() { t_writeTick = m_prev; }
+    WriteTickScope(const WriteTickScope&) = delete;
+    WriteTickScope& operator=(const WriteTickScope&) = delete;
+
+private:
+    WriteTick m_prev;
+};
+
+} // namespace detail
+
 // Interface para manejar pools sin conocer el tipo T
 struct IComponentPool {
+    static constexpr uint32_t InvalidDense = 0xFFFFFFFFu;
+
     virtual ~IComponentPool() = default;
     virtual void removeIfExists(Entity e) = 0;
     virtual void clear() = 0;
     virtual size_t size() const = 0;
+
+    // Usados por los owning groups del Registry, que reordenan varios
+    // pools en lockstep sin conocer sus tipos.
+    virtual uint32_t denseIndex(Entity e) const = 0;
+    virtual void swapDense(uint32_t a, uint32_t b) = 0;
+    virtual const std::vector<Entity>& denseEntities() const = 0;
 };
 
 template <typename T>
@@ -27,80 +89,241 @@ class ComponentPool final : public IComponentPool {
         "ECS components must be move-assignable (needed for swap-remove).");
 
 public:
+    /// Tipos vacios (PlayerTag, marcadores tipo "static"/"sleeping") no
+    /// guardan componentes: el pool es solo el sparse set + ticks de alta.
+    static constexpr bool IsEmpty = std::is_empty_v<T>;
+
     ComponentPool() = default;
 
-    bool has(Entity e) const {
-        if (e.index >= m_sparse.size()) return false;
-        uint32_t denseIndex = m_sparse[e.index];
-        if (denseIndex == InvalidDense) return false;
+    // ── Change tracking ──
+    // Cada posicion densa guarda dos ticks: cuando se agrego el componente
+    // y cuando se modifico por ultima vez. El tick actual lo provee el
+    // Registry (setTickSource): el del sistema que corre en este thread
+    // (detail::t_writeTick) o, fuera de un sistema, el global. Un pool
+    // suelto usa siempre 0.
+    // Los tipos vacios no se pueden modificar: solo guardan el tick de alta
+    // y changedTick() devuelve ese mismo.
+
+    void setTickSource(const std::atomic<uint32_t>* tick) { m_tick = tick; }
+    uint32_t currentTick() const {
+        const detail::WriteTick& write = detail::t_writeTick;
+        return write.source == m_tick ? write.tick : m_tick->load(std::memory_order_relaxed);
+    }
+
+    uint32_t addedTick(uint32_t dense) const   { return m_addedTicks[dense]; }
+    uint32_t changedTick(uint32_t dense) const {
+        if constexpr (IsEmpty) return m_addedTicks[dense];
+        else return m_changedTicks[dense];
+    }
+
+    void markChanged(uint32_t dense) {
+        if constexpr (!IsEmpty) m_changedTicks[dense] = currentTick();
+        else (void)dense;
+    }
+
+    /// Marca [begin, end) como modificados de una vez (Group::each).
+    void markChanged(uint32_t begin, uint32_t end) {
+        if constexpr (!IsEmpty) {
+            std::fill(m_changedTicks.begin() + begin, m_changedTicks.begin() + end, currentTick());
+        } else {
+            (void)begin;
+            (void)end;
+        }
+    }
+
+    /// Indice en el dense array del componente de e, o InvalidDense si e
+    /// no lo tiene. Resuelve membresia y posicion con una sola lectura del
+    /// sparse; las Views lo usan para no pagar has() + get() por separado.
+    uint32_t denseIndex(Entity e) const override {
+        uint32_t idx = sparseAt(e.index);
+        if (idx == InvalidDense) return InvalidDense;
         // Verificamos index Y generation para detectar handles stale.
         // Si la entidad fue destruida y el slot reutilizado, la generation
-        // no va a coincidir y retornamos false correctamente.
-        return m_denseEntities[denseIndex] == e;
+        // no va a coincidir y retornamos InvalidDense correctamente.
+        if (m_denseEntities[idx] != e) return InvalidDense;
+        return idx;
+    }
+
+    bool has(Entity e) const {
+        return denseIndex(e) != InvalidDense;
     }
 
     T& get(Entity e) {
         assert(has(e));
-        return m_denseComponents[m_sparse[e.index]];
+        return m_denseComponents[sparseAt(e.index)];
     }
 
     const T& get(Entity e) const {
         assert(has(e));
-        return m_denseComponents[m_sparse[e.index]];
+        return m_denseComponents[sparseAt(e.index)];
     }
 
     template <typename... Args>
     T& emplace(Entity e, Args&&... args) {
-        ensureSparseSize(e.index);
-
         if (has(e)) {
             // si ya existe, lo reasignamos
-            T& existing = get(e);
-            existing = T(std::forward<Args>(args)...);
+            const uint32_t dense = sparseAt(e.index);
+            T& existing = m_denseComponents[dense];
+            if constexpr (!IsEmpty) existing = T(std::forward<Args>(args)...);
+            markChanged(dense);
             return existing;
         }
 
         uint32_t denseIndex = static_cast<uint32_t>(m_denseEntities.size());
         m_denseEntities.push_back(e);
-        m_denseComponents.emplace_back(std::forward<Args>(args)...);
-        m_sparse[e.index] = denseIndex;
-        return m_denseComponents.back();
+        if constexpr (!IsEmpty) {
+            m_denseComponents.emplace_back(std::forward<Args>(args)...);
+            m_changedTicks.push_back(currentTick());
+        }
+        m_addedTicks.push_back(currentTick());
+        sparseSlot(e.index) = denseIndex;
+        return m_denseComponents[denseIndex];
     }
 
     void remove(Entity e) {
         if (!has(e)) return;
 
-        uint32_t denseIndex = m_sparse[e.index];
+        uint32_t denseIndex = sparseAt(e.index);
         uint32_t lastIndex = static_cast<uint32_t>(m_denseEntities.size() - 1);
 
         if (denseIndex != lastIndex) {
             // swap-remove para O(1)
             m_denseEntities[denseIndex] = m_denseEntities[lastIndex];
-            m_denseComponents[denseIndex] = std::move(m_denseComponents[lastIndex]);
+            m_addedTicks[denseIndex] = m_addedTicks[lastIndex];
+            if constexpr (!IsEmpty) m_changedTicks[denseIndex] = m_changedTicks[lastIndex];
 
             // actualizar sparse del que movimos
             Entity moved = m_denseEntities[denseIndex];
-            m_sparse[moved.index] = denseIndex;
+            sparseSlot(moved.index) = denseIndex;
         }
 
         m_denseEntities.pop_back();
-        m_denseComponents.pop_back();
-        m_sparse[e.index] = InvalidDense;
+        m_addedTicks.pop_back();
+        if constexpr (!IsEmpty) {
+            m_denseComponents.swapRemove(denseIndex);
+            m_changedTicks.pop_back();
+        }
+        sparseSlot(e.index) = InvalidDense;
     }
 
     // IComponentPool
     void removeIfExists(Entity e) override { remove(e); }
     void clear() override {
         m_denseEntities.clear();
-        m_denseComponents.clear();
-        m_sparse.clear();
+        m_addedTicks.clear();
+        if constexpr (!IsEmpty) {
+            m_denseComponents.clear();
+            m_changedTicks.clear();
+        }
+        m_sparsePages.clear();
     }
     size_t size() const override { return m_denseEntities.size(); }
 
-    // Iteración (más adelante la vamos a usar para queries)
-    const std::vector<Entity>& denseEntities() const { return m_denseEntities; }
-    std::vector<T>& denseComponents() { return m_denseComponents; }
-    const std::vector<T>& denseComponents() const { return m_denseComponents; }
+    /// Reserva lugar en los dense arrays para n componentes en total
+    /// (spawns masivos: una sola realocacion en vez de varias).
+    void reserve(size_t n) {
+        m_denseEntities.reserve(n);
+        m_addedTicks.reserve(n);
+        if constexpr (!IsEmpty) {
+            m_denseComponents.reserve(n);
+            m_changedTicks.reserve(n);
+        }
+    }
+
+    /// Intercambia dos posiciones del dense array (entidad + componente) y
+    /// actualiza el sparse de ambas. No cambia que entidades tienen el
+    /// componente, solo su orden; lo usan los owning groups para empaquetar.
+    void swapDense(uint32_t a, uint32_t b) override {
+        assert(a < m_denseEntities.size() && b < m_denseEntities.size());
+        if (a == b) return;
+        using std::swap;
+        swap(m_denseEntities[a], m_denseEntities[b]);
+        swap(m_addedTicks[a], m_addedTicks[b]);
+        if constexpr (!IsEmpty) {
+            m_denseComponents.swapElements(a, b);
+            swap(m_changedTicks[a], m_changedTicks[b]);
+        }
+        sparseSlot(m_denseEntities[a].index) = a;
+        sparseSlot(m_denseEntities[b].index) = b;
+    }
+
+    // ── Orden del dense array ──
+    // Reordenan entidades, componentes y ticks juntos y actualizan el
+    // sparse: cambia el orden de iteracion, no que entidades tienen T.
+    // Los movimientos se hacen con swaps de a pares via swap(a, b) para que
+    // el Registry pueda mover otros pools en lockstep (owning groups).
+
+    /// Ordena todo el pool. compare puede recibir (const T&, const T&) o
+    /// (Entity, Entity).
+    template <typename Compare>
+    void sort(Compare compare, SortAlgorithm algo = SortAlgorithm::Insertion) {
+        sortRange(0, static_cast<uint32_t>(size()), compare, algo,
+                  [this](uint32_t a, uint32_t b) { swapDense(a, b); });
+    }
+
+    /// Deja al frente del pool, en el mismo orden que en other, a las
+    /// entidades que estan en ambos pools. El resto queda despues.
+    void sortAs(const IComponentPool& other) {
+        sortAsRange(other, 0, static_cast<uint32_t>(size()),
+                    [this](uint32_t a, uint32_t b) { swapDense(a, b); });
+    }
+
+    /// Ordena solo [first, last) moviendo elementos con swap(a, b).
+    template <typename Compare, typename Swap>
+    void sortRange(uint32_t first, uint32_t last, Compare& compare, SortAlgorithm algo, Swap&& swap) {
+        assert(first <= last && last <= size());
+        if (last - first < 2) return;
+
+        auto less = [&](uint32_t a, uint32_t b) -> bool {
+            if constexpr (std::is_invocable_r_v<bool, Compare&, const T&, const T&>) {
+                return compare(std::as_const(m_denseComponents[a]), std::as_const(m_denseComponents[b]));
+            } else {
+                return compare(m_denseEntities[a], m_denseEntities[b]);
+            }
+        };
+
+        if (algo == SortAlgorithm::Insertion) {
+            for (uint32_t i = first + 1; i < last; ++i) {
+                for (uint32_t j = i; j > first && less(j, j - 1); --j) {
+                    swap(j - 1, j);
+                }
+            }
+            return;
+        }
+
+        // Std: ordenar las entidades del rango y despues llevar cada una a
+        // su lugar. Las posiciones < pos ya son finales, asi que la entidad
+        // que va en pos siempre esta en pos o mas adelante.
+        std::vector<Entity> order(m_denseEntities.begin() + first, m_denseEntities.begin() + last);
+        std::sort(order.begin(), order.end(), [&](Entity a, Entity b) {
+            return less(sparseAt(a.index), sparseAt(b.index));
+        });
+        for (uint32_t pos = first; pos < last; ++pos) {
+            const uint32_t current = sparseAt(order[pos - first].index);
+            if (current != pos) swap(pos, current);
+        }
+    }
+
+    /// sortAs() restringido a [first, last).
+    template <typename Swap>
+    void sortAsRange(const IComponentPool& other, uint32_t first, uint32_t last, Swap&& swap) {
+        assert(first <= last && last <= size());
+        uint32_t pos = first;
+        for (Entity e : other.denseEntities()) {
+            if (pos == last) return;
+            const uint32_t idx = denseIndex(e);
+            if (idx == InvalidDense || idx < pos || idx >= last) continue;
+            if (idx != pos) swap(pos, idx);
+            ++pos;
+        }
+    }
+
+    // Iteración (usado por Registry::View y Registry::Group)
+    const std::vector<Entity>& denseEntities() const override { return m_denseEntities; }
+    // Para tipos vacios devuelven un EmptyComponentArray (indexable igual,
+    // sin memoria detras).
+    auto& denseComponents() { return m_denseComponents; }
+    const auto& denseComponents() const { return m_denseComponents; }
 
 private:
     // Limite maximo de entidades para evitar que un bug aloque gigabytes.
@@ -108,19 +331,52 @@ private:
     // Si necesitas mas, simplemente subi este valor.
     static constexpr uint32_t MaxEntities = 1'048'576; // 2^20
 
-    void ensureSparseSize(uint32_t entityIndex) {
+    // ── Sparse paginado ──
+    // En vez de un vector de tamano (indice maximo + 1), el sparse se parte
+    // en paginas de SparsePageSize entradas que se alocan recien cuando una
+    // entidad de ese rango recibe el componente. Un pool con un solo
+    // PlayerTag en una entidad de indice alto cuesta UNA pagina (16 KB) en
+    // vez de 4 bytes * indice. Rangos sin componentes = pagina nullptr.
+    static constexpr uint32_t SparsePageBits = 12;
+    static constexpr uint32_t SparsePageSize = 1u << SparsePageBits; // 4096 entradas
+    static constexpr uint32_t SparsePageMask = SparsePageSize - 1;
+
+    using SparsePage = std::array<uint32_t, SparsePageSize>;
+
+    /// Lectura O(1): InvalidDense si la pagina no existe.
+    uint32_t sparseAt(uint32_t entityIndex) const {
+        const uint32_t page = entityIndex >> SparsePageBits;
+        if (page >= m_sparsePages.size() || !m_sparsePages[page]) return InvalidDense;
+        return (*m_sparsePages[page])[entityIndex & SparsePageMask];
+    }
+
+    /// Referencia escribible a la entrada de entityIndex (aloca la pagina
+    /// si hace falta, inicializada en InvalidDense).
+    uint32_t& sparseSlot(uint32_t entityIndex) {
         assert(entityIndex < MaxEntities && "Entity index exceeds MaxEntities limit!");
-        if (entityIndex >= m_sparse.size()) {
-            m_sparse.resize(entityIndex + 1, InvalidDense);
+        const uint32_t page = entityIndex >> SparsePageBits;
+        if (page >= m_sparsePages.size()) {
+            m_sparsePages.resize(page + 1);
         }
+        auto& p = m_sparsePages[page];
+        if (!p) {
+            p = std::make_unique<SparsePage>();
+            p->fill(InvalidDense);
+        }
+        return (*p)[entityIndex & SparsePageMask];
     }
 
 private:
-    static constexpr uint32_t InvalidDense = 0xFFFFFFFFu;
-
-    std::vector<uint32_t> m_sparse;        // [entityIndex] -> denseIndex
+    std::vector<std::unique_ptr<SparsePage>> m_sparsePages; // [entityIndex / PageSize] -> pagina
     std::vector<Entity>   m_denseEntities; // dense
-    std::vector<T>        m_denseComponents;
+    using ComponentArray = std::conditional_t<IsEmpty, detail::EmptyComponentArray<T>, ComponentStorage<T>>;
+    [[no_unique_address]] ComponentArray m_denseComponents;
+
+    // Change tracking (paralelos a los dense arrays).
+    static inline const std::atomic<uint32_t> s_noTick{0};
+    const std::atomic<uint32_t>* m_tick = &s_noTick;
+    std::vector<uint32_t> m_addedTicks;
+    std::vector<uint32_t> m_changedTicks; // vacio para tipos vacios
 };
 
 } // namespace eng::ecs
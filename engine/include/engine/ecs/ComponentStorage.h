@@ -0,0 +1,196 @@
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+
+namespace eng::ecs {
+
+/// true si T se puede mover de lugar copiando sus bytes (memcpy) sin
+/// llamar al move constructor del destino ni al destructor del original.
+/// Por defecto solo los trivially copyable. Optar es seguro solo si
+/// ningun miembro guarda punteros a si mismo en NINGUNA standard library
+/// ni modo de build que compilemos:
+///   template <> struct IsRelocatable<MiComponente> : std::true_type {};
+/// Seguros: trivially copyable, punteros/handles crudos y
+/// std::unique_ptr<T> con el deleter default.
+/// NO seguros:
+/// - std::string: el SSO de libstdc++ apunta a su propio buffer inline
+/// - std::vector: MSVC en debug (_ITERATOR_DEBUG_LEVEL > 0) guarda
+///   back-pointers
+/// - std::function, std::list, std::map, ...
+/// Ante la duda no optar: el camino con move es correcto siempre.
+template <typename T>
+struct IsRelocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template <typename T>
+inline constexpr bool IsRelocatableV = IsRelocatable<T>::value;
+
+/// Array dinamico de componentes de un ComponentPool (hace lo que hacia
+/// un std::vector<T>, con solo las operaciones que el pool necesita).
+///
+/// Para tipos relocatable:
+/// - crecer es un realloc: un memcpy en bloque, o ninguna copia si el
+///   allocator puede extender el bloque (los bloques grandes en glibc
+///   crecen con mremap)
+/// - swapRemove() copia los bytes del ultimo al hueco en vez de
+///   move-assign + destruir
+/// - swapElements() intercambia bytes en vez de tres moves
+/// El resto de los tipos usa move constructor / move assignment como
+/// std::vector.
+template <typename T>
+class ComponentStorage {
+    static constexpr bool Relocatable = IsRelocatableV<T>;
+    // realloc solo garantiza la alineacion de max_align_t.
+    static constexpr bool UseRealloc = Relocatable && alignof(T) <= alignof(std::max_align_t);
+
+public:
+    ComponentStorage() = default;
+    ~ComponentStorage() {
+        destroyRange(0, m_size);
+        deallocate(m_data);
+    }
+
+    ComponentStorage(const ComponentStorage&) = delete;
+    ComponentStorage& operator=(const ComponentStorage&) = delete;
+
+    size_t size() const { return m_size; }
+    size_t capacity() const { return m_capacity; }
+    bool empty() const { return m_size == 0; }
+
+    T*       data()       { return m_data; }
+    const T* data() const { return m_data; }
+
+    T&       operator[](size_t i)       { assert(i < m_size); return m_data[i]; }
+    const T& operator[](size_t i) const { assert(i < m_size); return m_data[i]; }
+
+    T& back() { assert(m_size > 0); return m_data[m_size - 1]; }
+
+    void reserve(size_t n) {
+        if (n > m_capacity) reallocate(n);
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (m_size == m_capacity) {
+            // Construir antes de crecer: args puede referenciar un elemento
+            // de este mismo array.
+            if constexpr (Relocatable) {
+                alignas(T) unsigned char tmp[sizeof(T)];
+                T* value = ::new (static_cast<void*>(tmp)) T(std::forward<Args>(args)...);
+                try {
+                    reallocate(grownCapacity());
+                } catch (...) {
+                    value->~T(); // tmp no es un objeto con scope: destruirlo a mano
+                    throw;
+                }
+                std::memcpy(static_cast<void*>(m_data + m_size), tmp, sizeof(T));
+            } else {
+                T tmp(std::forward<Args>(args)...);
+                reallocate(grownCapacity());
+                ::new (static_cast<void*>(m_data + m_size)) T(std::move(tmp));
+            }
+        } else {
+            ::new (static_cast<void*>(m_data + m_size)) T(std::forward<Args>(args)...);
+        }
+        return m_data[m_size++];
+    }
+
+    void pop_back() {
+        assert(m_size > 0);
+        --m_size;
+        m_data[m_size].~T();
+    }
+
+    /// Saca el elemento i moviendo el ultimo a su lugar (O(1)).
+    void swapRemove(size_t i) {
+        assert(i < m_size);
+        const size_t last = m_size - 1;
+        if (i != last) {
+            if constexpr (Relocatable) {
+                m_data[i].~T();
+                std::memcpy(static_cast<void*>(m_data + i), static_cast<const void*>(m_data + last), sizeof(T));
+                m_size = last; // el ultimo ya no se destruye: sus bytes viven en i
+                return;
+            } else {
+                m_data[i] = std::move(m_data[last]);
+            }
+        }
+        pop_back();
+    }
+
+    void swapElements(size_t a, size_t b) {
+        assert(a < m_size && b < m_size);
+        if constexpr (Relocatable) {
+            alignas(T) unsigned char tmp[sizeof(T)];
+            std::memcpy(tmp, static_cast<const void*>(m_data + a), sizeof(T));
+            std::memcpy(static_cast<void*>(m_data + a), static_cast<const void*>(m_data + b), sizeof(T));
+            std::memcpy(static_cast<void*>(m_data + b), tmp, sizeof(T));
+        } else {
+            using std::swap;
+            swap(m_data[a], m_data[b]);
+        }
+    }
+
+    /// Destruye todo; conserva la capacidad.
+    void clear() {
+        destroyRange(0, m_size);
+        m_size = 0;
+    }
+
+private:
+    size_t grownCapacity() const {
+        return m_capacity < 8 ? 8 : m_capacity * 2;
+    }
+
+    void destroyRange(size_t begin, size_t end) {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = begin; i < end; ++i) m_data[i].~T();
+        } else {
+            (void)begin;
+            (void)end;
+        }
+    }
+
+    void reallocate(size_t newCapacity) {
+        assert(newCapacity >= m_size);
+        if constexpr (UseRealloc) {
+            void* p = std::realloc(m_data, newCapacity * sizeof(T));
+            if (!p) throw std::bad_alloc();
+            m_data = static_cast<T*>(p);
+        } else {
+            T* fresh = static_cast<T*>(::operator new(newCapacity * sizeof(T), std::align_val_t{alignof(T)}));
+            if constexpr (Relocatable) {
+                if (m_size > 0) {
+                    std::memcpy(static_cast<void*>(fresh), static_cast<const void*>(m_data), m_size * sizeof(T));
+                }
+            } else {
+                for (size_t i = 0; i < m_size; ++i) {
+                    ::new (static_cast<void*>(fresh + i)) T(std::move_if_noexcept(m_data[i]));
+                }
+                destroyRange(0, m_size);
+            }
+            deallocate(m_data);
+            m_data = fresh;
+        }
+        m_capacity = newCapacity;
+    }
+
+    static void deallocate(T* p) {
+        if (!p) return;
+        if constexpr (UseRealloc) {
+            std::free(p);
+        } else {
+            ::operator delete(p, std::align_val_t{alignof(T)});
+        }
+    }
+
+    T*     m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_capacity = 0;
+};
+
+} // namespace eng::ecs
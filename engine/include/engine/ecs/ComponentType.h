@@ -0,0 +1,111 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+
+namespace eng::ecs {
+
+/// ID numerico de un tipo de componente ("family ID").
+/// Son secuenciales (0, 1, 2, ...) asi el Registry los usa directamente
+/// como indice en un array plano de pools, sin hashing.
+using ComponentTypeId = uint32_t;
+
+/// Maximo de tipos que puede trackear una ComponentMask. Cuenta todo lo
+/// que pide un ID: componentes y tambien los recursos de SystemAccess
+/// (Input, Renderer2D, AnimationLibrary, SoAMotionPool...).
+inline constexpr ComponentTypeId MaxComponentTypes = 128;
+
+namespace detail {
+
+// Contador global compartido por todos los tipos. Atomico porque el primer
+// uso de un tipo puede ocurrir desde cualquier thread. Pasarse de
+// MaxComponentTypes aborta en cualquier build: las masks (Slot,
+// SystemAccess, exclude) escribirian fuera de su array. Corre una sola
+// vez por tipo.
+inline ComponentTypeId nextComponentTypeId() {
+    static std::atomic<ComponentTypeId> s_counter{0};
+    const ComponentTypeId id = s_counter.fetch_add(1, std::memory_order_relaxed);
+    if (id >= MaxComponentTypes) {
+        std::fprintf(stderr, "[ECS] Too many component types (max %u): raise MaxComponentTypes\n",
+                     static_cast<unsigned>(MaxComponentTypes));
+        std::abort();
+    }
+    return id;
+}
+
+template <typename T>
+struct ComponentTypeIdHolder {
+    // Se inicializa una sola vez por tipo (static local = thread-safe).
+    static ComponentTypeId get() {
+        static const ComponentTypeId s_id = nextComponentTypeId();
+        return s_id;
+    }
+};
+
+} // namespace detail
+
+/// Retorna el ID del tipo de componente T. Estable durante toda la ejecucion
+/// (pero NO entre ejecuciones: depende del orden en que se usan los tipos,
+/// asi que nunca hay que serializarlo).
+/// const/volatile se ignoran: Transform2D y const Transform2D comparten ID.
+template <typename T>
+ComponentTypeId componentTypeId() {
+    return detail::ComponentTypeIdHolder<std::remove_cv_t<T>>::get();
+}
+
+/// Set de tipos de componente (un bit por ComponentTypeId). Cada Slot del
+/// Registry guarda el suyo: destroy() recorre solo los bits prendidos en
+/// vez de todos los pools.
+class ComponentMask {
+public:
+    void set(ComponentTypeId id)         { assert(id < MaxComponentTypes); m_words[id >> 6] |= bit(id); }
+    void reset(ComponentTypeId id)       { assert(id < MaxComponentTypes); m_words[id >> 6] &= ~bit(id); }
+    bool test(ComponentTypeId id) const  { assert(id < MaxComponentTypes); return (m_words[id >> 6] & bit(id)) != 0; }
+    void clear()                         { m_words.fill(0); }
+
+    bool none() const {
+        for (uint64_t w : m_words) if (w) return false;
+        return true;
+    }
+
+    /// true si algun tipo esta en los dos sets.
+    bool intersects(const ComponentMask& other) const {
+        uint64_t any = 0;
+        for (size_t w = 0; w < Words; ++w) any |= m_words[w] & other.m_words[w];
+        return any != 0;
+    }
+
+    /// true si todos los tipos de other estan en este set.
+    bool contains(const ComponentMask& other) const {
+        uint64_t missing = 0;
+        for (size_t w = 0; w < Words; ++w) missing |= other.m_words[w] & ~m_words[w];
+        return missing == 0;
+    }
+
+    /// Llama fn(ComponentTypeId) por cada bit prendido, en orden creciente.
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t w = 0; w < Words; ++w) {
+            uint64_t bits = m_words[w];
+            while (bits) {
+                const int b = std::countr_zero(bits);
+                fn(static_cast<ComponentTypeId>(w * 64 + static_cast<size_t>(b)));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+private:
+    static constexpr size_t Words = MaxComponentTypes / 64;
+    static uint64_t bit(ComponentTypeId id) { return uint64_t{1} << (id & 63); }
+
+    std::array<uint64_t, Words> m_words{};
+};
+
+} // namespace eng::ecs
@@ -4,6 +4,7 @@
 #include <vector>
 #include "engine/render/Texture.h"
 #include "engine/render/Tileset.h"
+#include "engine/render/AnimationLibrary.h"
 
 namespace eng::ecs {
 
@@ -47,21 +48,34 @@ struct Sprite {
     bool               flipX   = false;   // espejado horizontal
 };
 
-/// Clip de animacion: una secuencia de frames UV dentro de un sprite sheet.
-/// Cada frame es un Rect con las coordenadas UV de ese frame en la textura.
-struct AnimationClip {
-    std::string name;                 // "idle", "walk_down", etc.
-    std::vector<eng::Rect> frames;    // UVs de cada frame
-    float frameDuration = 0.15f;      // segundos por frame (~6 FPS)
-    bool loop = true;                 // repetir al terminar?
-};
+// AnimationClip (la descripcion de un clip) vive en AnimationLibrary.h.
+using eng::AnimationClip;
 
+/// Estado de animacion de una entidad. POD chico: los clips estan en el
+/// AnimationLibrary (reg.ctx().animations) y aca solo hay un handle al set
+/// de clips y la posicion de reproduccion.
 struct SpriteAnimator {
-    std::vector<AnimationClip> clips;
-    int currentClip = 0;
-    int currentFrame = 0;
-    float timer = 0.0f;
-    bool playing = true;
+    eng::ClipSetHandle clipSet = eng::InvalidClipSet;
+    uint16_t currentClip  = 0;     // indice dentro del set
+    uint16_t currentFrame = 0;
+    float    timer = 0.0f;
+    float    speed = 1.0f;         // multiplicador (variar el ritmo entre NPCs que comparten set)
+    bool     playing = true;
+};
+
+/// Animacion sin estado por frame: solo el clip y cuando arranco. El frame
+/// se calcula en forma cerrada con el reloj del AnimationLibrary
+/// (floor((now - startTime) * speed / frameDuration) % frameCount) y
+/// RenderSystem lo resuelve SOLO al dibujar la entidad, asi que
+/// AnimationSystem no la recorre y una entidad fuera de pantalla no cuesta
+/// nada. Para loops que no se pausan (NPCs y animales en idle); el player
+/// sigue con SpriteAnimator. Cambiar de clip = setear clip y
+/// startTime = animations->now().
+struct TimedSpriteAnimator {
+    eng::ClipSetHandle clipSet = eng::InvalidClipSet;
+    uint16_t clip  = 0;            // indice dentro del set
+    float    speed = 1.0f;         // multiplicador (igual que SpriteAnimator)
+    double   startTime = 0.0;      // AnimationLibrary::now() al arrancar el clip
 };
 
 /// Capa de tiles. Grilla flat row-major: tiles[row * width + col].
@@ -1,20 +1,28 @@
 #pragma once
 #include "engine/ecs/Entity.h"
 #include "engine/ecs/ComponentPool.h"
+#include "engine/ecs/ComponentType.h"
+#include "engine/ecs/SoAMotion.h"
 
 #include <vector>
-#include <unordered_map>
-#include <typeindex>
 #include <memory>
 #include <cstdint>
+#include <atomic>
 #include <cassert>
 #include <tuple>
+#include <array>
+#include <utility>
+#include <type_traits>
 #include <initializer_list>
 #include <limits>
+#include <span>
+#include <typeinfo>
+#include "engine/JobSystem.h"
+#include "engine/ecs/SystemAccess.h"
 
 // Forward declarations para EngineContext (evitamos incluir headers pesados).
 struct SDL_Window;
-namespace eng { class Renderer2D; class Profiler; class TextureManager; }
+namespace eng { class Renderer2D; class Profiler; class TextureManager; class JobSystem; class AnimationLibrary; }
 namespace eng::ecs { class SystemScheduler; }
 
 namespace eng::ecs {
@@ -29,12 +37,75 @@ struct EngineContext {
     Profiler*         profiler  = nullptr;
     SystemScheduler*  scheduler = nullptr;
     TextureManager*   textures  = nullptr;
+    JobSystem*        jobs      = nullptr; // jobs + parallelEach() de View/Group
+    AnimationLibrary* animations = nullptr; // clips compartidos de SpriteAnimator
+};
+
+/// Parte de las entidades que le toca procesar a un sistema con
+/// time-slicing (SystemScheduler::setTimeSlices): la entidad e es del
+/// slice e.index % count. El reparto es por indice de entidad (no por
+/// posicion densa) para que sea estable aunque los pools se reordenen o
+/// hagan swap-remove: cada entidad se procesa exactamente una vez cada
+/// count corridas.
+struct TimeSlice {
+    uint32_t index = 0;
+    uint32_t count = 1;
+
+    bool all() const { return count <= 1; }
+    bool contains(Entity e) const { return count <= 1 || e.index % count == index; }
 };
 
 class Registry {
+    struct GroupData; // estado de un owning group (ver group<Ts...>())
+
+    // Pool de T ignorando const (view<const T> lee del mismo pool que view<T>).
+    template <typename T>
+    using PoolFor = ComponentPool<std::remove_const_t<T>>;
+
+    // ── Llamada a los callbacks de each() ──
+    // fn puede recibir (Entity, Ts&...), (Ts&...) o las mismas dos formas
+    // sin los tipos vacios (tags), que solo aportan membresia:
+    //   reg.view<Transform2D, SleepingTag>().each([](Transform2D& t) { ... });
+
+    template <typename C>
+    static auto refIfData(C& c) {
+        if constexpr (std::is_empty_v<std::remove_const_t<C>>) return std::tuple<>{};
+        else return std::tuple<C&>(c);
+    }
+
+    template <typename Fn, typename Args>
+    struct InvocableWithTuple;
+    template <typename Fn, typename... Args>
+    struct InvocableWithTuple<Fn, std::tuple<Args...>> : std::is_invocable<Fn&, Args...> {};
+
+    template <typename Fn, typename... Cs>
+    static void invokeEach(Fn& fn, Entity e, Cs&... cs) {
+        if constexpr (std::is_invocable_v<Fn&, Entity, Cs&...>) {
+            fn(e, cs...);
+        } else if constexpr (std::is_invocable_v<Fn&, Cs&...>) {
+            fn(cs...);
+        } else {
+            using Data = decltype(std::tuple_cat(refIfData(cs)...));
+            if constexpr (InvocableWithTuple<Fn, decltype(std::tuple_cat(std::tuple<Entity>(), std::declval<Data>()))>::value) {
+                std::apply([&](auto&... data) { fn(e, data...); }, std::tuple_cat(refIfData(cs)...));
+            } else {
+                static_assert(InvocableWithTuple<Fn, Data>::value,
+                    "each() expects fn(Entity, Ts&...) or fn(Ts&...) (empty tag types may be omitted).");
+                std::apply([&](auto&... data) { fn(data...); }, std::tuple_cat(refIfData(cs)...));
+            }
+        }
+    }
+
 public:
+    /// Entidades por rango en parallelEach() si no se indica otro.
+    static constexpr size_t DefaultGrainSize = 4096;
+
     Registry() = default;
 
+    // Los pools y las views guardan punteros al registry (tick, lock).
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
     // ── Context (acceso a subsistemas del motor) ────────────────
     void setContext(const EngineContext& ctx) { m_ctx = ctx; }
     EngineContext&       ctx()       { return m_ctx; }
@@ -43,61 +114,403 @@ public:
     Entity create();
     void destroy(Entity e);
 
+    // ── Operaciones en lote (spawns/clears masivos) ──
+
+    /// Crea out.size() entidades y las escribe en out. Reusa primero los
+    /// indices libres y reserva el resto de los slots de una vez.
+    void create(std::span<Entity> out);
+
+    /// Destruye todas las entidades de la lista (las muertas se ignoran).
+    void destroy(std::span<const Entity> entities);
+
     bool isAlive(Entity e) const;
 
     size_t aliveCount() const { return m_aliveCount; }
 
+    /// true mientras hay un parallelEach() en curso: no se permiten cambios
+    /// estructurales (los dense arrays se estan recorriendo desde varios threads).
+    bool structureLocked() const { return m_structureLocks.load(std::memory_order_relaxed) != 0; }
+
+    /// true mientras corre en este thread un sistema lanzado en paralelo por
+    /// el SystemScheduler (SystemRunScope). Ahi no se pueden crear pools ni
+    /// grupos: otros sistemas leen m_pools/m_groups a la vez. Cada sistema
+    /// corre una vez en serie antes (ver SystemScheduler::runPhase).
+    bool inParallelSystem() const { return detail::t_writeTick.source == &m_tick; }
+
     template <typename T>
     bool has(Entity e) {
+        checkAccess<const T>();
         auto* pool = tryGetPool<T>();
         return pool ? pool->has(e) : false;
     }
 
+    template <typename T>
+    bool has(Entity e) const {
+        checkAccess<const T>();
+        auto* pool = tryGetPoolConst<T>();
+        return pool ? pool->has(e) : false;
+    }
+
+    /// Membresia contra la ComponentMask de la entidad (un solo load, sin
+    /// tocar los pools): pensados para tags y marcadores.
+    template <typename... Ts>
+    bool hasAll(Entity e) const {
+        (checkAccess<const Ts>(), ...);
+        return isAlive(e) && m_slots[e.index].mask.contains(maskOf<Ts...>());
+    }
+
+    template <typename... Ts>
+    bool hasAny(Entity e) const {
+        (checkAccess<const Ts>(), ...);
+        return isAlive(e) && m_slots[e.index].mask.intersects(maskOf<Ts...>());
+    }
+
+    template <typename... Ts>
+    static ComponentMask maskOf() {
+        ComponentMask mask;
+        (mask.set(componentTypeId<Ts>()), ...);
+        return mask;
+    }
+
+    /// Acceso mutable: marca T como modificado (change tracking). Para
+    /// solo leer usar la version const (std::as_const(reg).get<T>(e)).
     template <typename T>
     T& get(Entity e) {
+        checkAccess<T>();
         auto* pool = getOrCreatePool<T>();
+        const uint32_t dense = pool->denseIndex(e);
+        assert(dense != IComponentPool::InvalidDense);
+        pool->markChanged(dense);
+        return pool->denseComponents()[dense];
+    }
+
+    template <typename T>
+    const T& get(Entity e) const {
+        checkAccess<const T>();
+        auto* pool = tryGetPoolConst<T>();
+        assert(pool);
         return pool->get(e);
     }
 
+    /// Modifica T in-place via fn(T&) y lo marca como modificado.
+    template <typename T, typename Fn>
+    T& patch(Entity e, Fn&& fn) {
+        T& value = get<T>(e);
+        fn(value);
+        return value;
+    }
+
+    /// Reemplaza T (que ya tiene que existir) y lo marca como modificado.
+    /// Si falta, en release lo agrega via emplace<T>() (mascara y grupos
+    /// al dia) en vez de dejar un componente que destroy() no ve.
+    template <typename T, typename... Args>
+    T& replace(Entity e, Args&&... args) {
+        assert(has<T>(e) && "replace<T>() needs an existing component, use emplace<T>()");
+        return emplace<T>(e, std::forward<Args>(args)...);
+    }
+
+    // ── Change tracking ──
+    // Un contador global de ticks. Cada ComponentPool guarda, por posicion
+    // densa, el tick en que se agrego y en que se modifico por ultima vez
+    // cada componente. El SystemScheduler avanza el tick antes de correr
+    // cada sistema y recuerda el tick de su ultima corrida (lastRunTick),
+    // que es contra lo que comparan los filtros changed<T>()/added<T>().
+    // El tick es atomico: con el scheduler paralelo varios sistemas lo
+    // avanzan y lo leen a la vez.
+
+    uint32_t tick() const { return m_tick.load(std::memory_order_relaxed); }
+    uint32_t advanceTick() { return m_tick.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+    /// lastRunTick del sistema que corre en este thread (SystemRunScope)
+    /// o, si no hay, el de setLastRunTick().
+    uint32_t lastRunTick() const;
+    void setLastRunTick(uint32_t tick) { m_lastRunTick = tick; }
+
+    /// Slice del sistema que corre (SystemRunScope o setTimeSlice()). Sin
+    /// time-slicing es {0, 1}: todas las entidades.
+    TimeSlice timeSlice() const;
+    void setTimeSlice(TimeSlice slice) { m_timeSlice = slice; }
+
+    /// Fija lastRunTick() y timeSlice() solo para el thread actual
+    /// mientras vive, y runTick como tick de lo que escriba (ver
+    /// detail::WriteTick). El scheduler paralelo la usa en vez de los
+    /// setters: cada thread corre un sistema distinto. Anidable.
+    class SystemRunScope {
+    public:
+        SystemRunScope(const Registry& reg, uint32_t runTick, uint32_t lastRunTick, TimeSlice slice = {});
+        ~SystemRunScope();
+        SystemRunScope(const SystemRunScope&) = delete;
+        SystemRunScope& operator=(const SystemRunScope&) = delete;
+
+    private:
+        const Registry* m_prevReg;
+        uint32_t m_prevTick;
+        TimeSlice m_prevSlice;
+        detail::WriteTickScope m_writeTick;
+    };
+
+    /// true si tick es posterior a since (tolera el wrap-around de uint32).
+    static bool tickNewer(uint32_t tick, uint32_t since) {
+        return static_cast<int32_t>(tick - since) > 0;
+    }
+
     template <typename T, typename... Args>
     T& emplace(Entity e, Args&&... args) {
         assert(isAlive(e));
+        checkAccess<T>();
         auto* pool = getOrCreatePool<T>();
-        return pool->emplace(e, std::forward<Args>(args)...);
+        GroupData* owner = ownerOf<T>();
+        if (pool->has(e)) {
+            return pool->emplace(e, std::forward<Args>(args)...); // reasigna, no es estructural
+        }
+        checkStructural("emplace");
+        assert(!structureLocked() && "Structural change during parallelEach!");
+        m_slots[e.index].mask.set(componentTypeId<T>());
+        if (!owner) {
+            return pool->emplace(e, std::forward<Args>(args)...);
+        }
+        pool->emplace(e, std::forward<Args>(args)...);
+        // El grupo puede mover el componente recien agregado al frente del
+        // pool, asi que la referencia se toma DESPUES de actualizarlo.
+        groupTryAdd(*owner, e);
+        return pool->get(e);
+    }
+
+    /// Agrega T (copia de value) a todas las entidades de la lista,
+    /// reservando el pool una sola vez. Las que ya lo tienen se reasignan.
+    template <typename T>
+    void emplaceRange(std::span<const Entity> entities, const T& value = T{}) {
+        emplaceRangeImpl<T>(entities, [&](size_t) -> const T& { return value; });
+    }
+
+    /// Igual, pero con un valor por entidad: entities[i] recibe values[i].
+    template <typename T>
+    void emplaceRange(std::span<const Entity> entities, std::span<const T> values) {
+        assert(values.size() == entities.size());
+        emplaceRangeImpl<T>(entities, [&](size_t i) -> const T& { return values[i]; });
+    }
+
+    /// Reserva lugar para n componentes T en total (ver emplaceRange).
+    template <typename T>
+    void reserve(size_t n) {
+        checkStructural("reserve");
+        getOrCreatePool<T>()->reserve(n);
     }
 
     template <typename T>
     void remove(Entity e) {
+        checkAccess<T>();
         auto* pool = tryGetPool<T>();
-        if (pool) pool->remove(e);
+        if (!pool || !pool->has(e)) return;
+        checkStructural("remove");
+        assert(!structureLocked() && "Structural change during parallelEach!");
+        if (GroupData* owner = ownerOf<T>()) {
+            groupRemove(*owner, e);
+        }
+        pool->remove(e);
+        m_slots[e.index].mask.reset(componentTypeId<T>());
     }
 
     template <typename T>
     size_t componentCount() const {
+        checkAccess<const T>();
         auto* pool = tryGetPoolConst<T>();
         return pool ? pool->size() : 0;
     }
 
     void clear();
 
+    // ── Orden de los pools ──
+    // Cambian el orden de iteracion de T (views que lo usan como driver,
+    // recorridos directos con storage<T>()), no el contenido.
+    // Si T es de un owning group, las entidades del grupo ([0, groupedCount<T>()))
+    // se ordenan entre si moviendo en lockstep a los otros pools del grupo, y
+    // el resto del pool se ordena aparte: quedan DOS tramos ordenados.
+
+    /// Ordena el pool de T. compare recibe (const T&, const T&) o (Entity, Entity).
+    template <typename T, typename Compare>
+    void sort(Compare compare, SortAlgorithm algo = SortAlgorithm::Insertion) {
+        assert(!structureLocked() && "sort() during parallelEach!");
+        checkAccess<T>();
+        auto* pool = tryGetPool<T>();
+        if (!pool) return;
+        const uint32_t grouped = static_cast<uint32_t>(groupedCount<T>());
+        if (grouped > 0) {
+            GroupData& owner = *ownerOf<T>();
+            pool->sortRange(0, grouped, compare, algo,
+                            [&](uint32_t a, uint32_t b) { groupSwap(owner, a, b); });
+        }
+        pool->sortRange(grouped, static_cast<uint32_t>(pool->size()), compare, algo,
+                        [&](uint32_t a, uint32_t b) { pool->swapDense(a, b); });
+    }
+
+    /// Reordena T para que las entidades que tambien tienen Other queden
+    /// en el mismo orden que en el pool de Other (al frente de cada tramo).
+    template <typename T, typename Other>
+    void sortAs() {
+        assert(!structureLocked() && "sortAs() during parallelEach!");
+        checkAccess<T>();
+        checkAccess<const Other>();
+        auto* pool = tryGetPool<T>();
+        const auto* other = tryGetPoolConst<Other>();
+        if (!pool || !other) return;
+        const uint32_t grouped = static_cast<uint32_t>(groupedCount<T>());
+        if (grouped > 0) {
+            GroupData& owner = *ownerOf<T>();
+            pool->sortAsRange(*other, 0, grouped,
+                              [&](uint32_t a, uint32_t b) { groupSwap(owner, a, b); });
+        }
+        pool->sortAsRange(*other, grouped, static_cast<uint32_t>(pool->size()),
+                          [&](uint32_t a, uint32_t b) { pool->swapDense(a, b); });
+    }
+
+    /// Cuantas entidades del frente del pool de T estan empaquetadas por
+    /// su owning group (0 si T no tiene grupo).
+    template <typename T>
+    size_t groupedCount() const {
+        checkAccess<const T>();
+        const GroupData* owner = ownerOf<T>();
+        return owner ? owner->size : 0;
+    }
+
+    /// Pool de T para recorrerlo directo en su orden denso (solo lectura,
+    /// nullptr si T todavia no tiene pool).
+    template <typename T>
+    const ComponentPool<T>* storage() const {
+        checkAccess<const T>();
+        return tryGetPoolConst<T>();
+    }
+
+    /// Query multi-componente. Resuelve los ComponentPool<Ts>* UNA sola vez
+    /// al construirse y elige como "driver" el pool mas chico: se recorre su
+    /// dense array y para el resto se chequea membresia directo contra el
+    /// sparse de cada pool (sin pasar por el Registry).
+    ///
+    /// Dos formas de iterar:
+    ///   for (auto [e, a, b] : view) { ... }           // iterador (structured bindings)
+    ///   view.each([](Entity e, A& a, B& b) { ... });  // fast path
+    /// each() lee el componente del driver por indice denso (sin sparse) y
+    /// es la forma recomendada en los loops calientes de los sistemas.
+    ///
+    /// Change tracking: los tipos no-const se marcan como modificados en
+    /// cada entidad visitada. Para solo leer, pedirlos const:
+    ///   reg.view<const Transform2D, const Sprite>()
+    /// Filtros (sobre tipos de la view) para procesar solo lo que cambio:
+    ///   reg.view<const Transform2D>().changed<Transform2D>().each(...)
+    ///   reg.view<Sprite>().added<Sprite>(sinceTick).each(...)
+    /// Sin argumento comparan contra reg.lastRunTick() (la ultima vez que
+    /// corrio el sistema actual).
+    ///
+    /// slice() deja solo la parte de las entidades que le toca a esta
+    /// corrida de un sistema con time-slicing (ver TimeSlice).
+    ///
+    /// exclude<Us...>() saca a las entidades que tengan alguno de Us:
+    ///   reg.view<Transform2D, const Sprite>().exclude<SleepingTag>().each(...)
+    /// Se chequea contra la ComponentMask de la entidad, sin tocar los pools
+    /// de Us. Los tipos vacios (tags) en Ts no tienen storage: solo aportan
+    /// membresia.
     template <typename... Ts>
     class View {
+        static_assert(sizeof...(Ts) > 0, "View needs at least one component type.");
+        static_assert(sizeof...(Ts) <= 32, "View supports up to 32 component types.");
+
+        using Pools = std::tuple<PoolFor<Ts>*...>;
+        using Indices = std::array<uint32_t, sizeof...(Ts)>;
+
+        /// Filtros activos. changed/added: bit I = filtro sobre el tipo I.
+        struct Filters {
+            uint32_t changedMask = 0;
+            uint32_t addedMask = 0;
+            std::array<uint32_t, sizeof...(Ts)> changedSince{};
+            std::array<uint32_t, sizeof...(Ts)> addedSince{};
+            ComponentMask excluded;
+            bool hasExcluded = false;
+            TimeSlice slice;
+
+            bool any() const { return (changedMask | addedMask) != 0 || hasExcluded || !slice.all(); }
+        };
+
     public:
-        View(Registry& reg) : m_reg(reg) {
+        View(Registry& reg)
+            : m_reg(&reg),
+              m_pools(reg.tryGetPool<std::remove_const_t<Ts>>()...) {
             // Elegimos el pool "driver": el más chico para iterar menos
             pickDriverPool();
         }
 
+        // Los filtros se encadenan sobre la view. Sobre un temporal
+        // devuelven la view por valor, asi
+        //   for (auto [e, t] : reg.view<T>().exclude<U>())
+        // no queda iterando una referencia a un temporal ya destruido.
+
+        /// Solo entidades cuyo T se modifico despues de sinceTick.
+        template <typename T>
+        View& changed(uint32_t sinceTick) & {
+            constexpr size_t I = indexOf<T>();
+            m_filters.changedMask |= 1u << I;
+            m_filters.changedSince[I] = sinceTick;
+            return *this;
+        }
+        template <typename T>
+        View changed(uint32_t sinceTick) && { return std::move(changed<T>(sinceTick)); }
+
+        template <typename T>
+        View& changed() & { return changed<T>(m_reg->lastRunTick()); }
+        template <typename T>
+        View changed() && { return std::move(changed<T>(m_reg->lastRunTick())); }
+
+        /// Solo entidades que recibieron T despues de sinceTick.
+        template <typename T>
+        View& added(uint32_t sinceTick) & {
+            constexpr size_t I = indexOf<T>();
+            m_filters.addedMask |= 1u << I;
+            m_filters.addedSince[I] = sinceTick;
+            return *this;
+        }
+        template <typename T>
+        View added(uint32_t sinceTick) && { return std::move(added<T>(sinceTick)); }
+
+        template <typename T>
+        View& added() & { return added<T>(m_reg->lastRunTick()); }
+        template <typename T>
+        View added() && { return std::move(added<T>(m_reg->lastRunTick())); }
+
+        /// Solo entidades que NO tienen ninguno de Us.
+        template <typename... Us>
+        View& exclude() & {
+            (m_reg->template checkAccess<const Us>(), ...);
+            (m_filters.excluded.set(componentTypeId<Us>()), ...);
+            m_filters.hasExcluded = true;
+            return *this;
+        }
+        template <typename... Us>
+        View exclude() && { return std::move(exclude<Us...>()); }
+
+        /// Solo las entidades de slice (ver TimeSlice). Sin argumento, el
+        /// del sistema que corre (reg.timeSlice()).
+        View& slice(TimeSlice part) & {
+            m_filters.slice = part;
+            return *this;
+        }
+        View slice(TimeSlice part) && { return std::move(slice(part)); }
+
+        View& slice() & { return slice(m_reg->timeSlice()); }
+        View slice() && { return std::move(slice(m_reg->timeSlice())); }
+
         class Iterator {
         public:
-            // Unico constructor: requiere la referencia al vector de entidades
-            // del driver pool. Las referencias en C++ DEBEN inicializarse,
-            // por eso no puede existir un constructor sin este parametro.
-            Iterator(Registry& reg,
-                     const std::vector<Entity>& driverEntities,
+            // El iterador copia los punteros a pools y los filtros (es
+            // barato) en vez de referenciar la View, asi sigue siendo valido
+            // aunque la View sea un temporal.
+            Iterator(const Registry* reg,
+                     const Pools& pools,
+                     const Filters& filters,
+                     const std::vector<Entity>* driverEntities,
                      size_t i,
                      size_t end)
                 : m_reg(reg),
+                  m_pools(pools),
+                  m_filters(filters),
                   m_driverEntities(driverEntities),
                   m_i(i),
                   m_end(end) {
@@ -115,102 +528,388 @@ public:
             }
 
             auto operator*() const {
-                Entity e = m_driverEntities[m_i];
-                return std::tuple<Entity, Ts&...>(e, m_reg.get<Ts>(e)...);
+                return deref(std::index_sequence_for<Ts...>{});
             }
 
         private:
+            template <size_t... Is>
+            auto deref(std::index_sequence<Is...> seq) const {
+                Entity e = (*m_driverEntities)[m_i];
+                Indices idx{};
+                resolveAll(m_pools, e, idx, seq);
+                (markIfMutable<Is>(m_pools, idx[Is]), ...);
+                return std::tuple<Entity, Ts&...>(
+                    e, std::get<Is>(m_pools)->denseComponents()[idx[Is]]...);
+            }
+
             void advanceToValid() {
                 while (m_i < m_end) {
-                    Entity e = m_driverEntities[m_i];
+                    Entity e = (*m_driverEntities)[m_i];
                     // Verificamos que la entidad tenga TODOS los componentes
-                    // requeridos. El driver pool garantiza al menos uno,
-                    // pero necesitamos chequear los demas.
-                    if ((m_reg.has<Ts>(e) && ...)) {
+                    // requeridos (y pase los filtros). El driver pool
+                    // garantiza al menos uno, los demas se chequean directo
+                    // contra su sparse.
+                    Indices idx{};
+                    if (resolveAll(m_pools, e, idx, std::index_sequence_for<Ts...>{}) &&
+                        (!m_filters.any() ||
+                         passesFilters(*m_reg, m_pools, m_filters, e, idx, std::index_sequence_for<Ts...>{}))) {
                         return;
                     }
                     ++m_i;
                 }
             }
 
-            Registry& m_reg;
-            const std::vector<Entity>& m_driverEntities;
+            const Registry* m_reg;
+            Pools m_pools;
+            Filters m_filters;
+            const std::vector<Entity>* m_driverEntities = nullptr;
             size_t m_i = 0;
             size_t m_end = 0;
         };
 
-        Iterator begin() {
-            if (!m_valid) {
-                static const std::vector<Entity> empty;
-                return Iterator(m_reg, empty, 0, 0);
-            }
-            return Iterator(m_reg, *m_driverEntities, 0, m_driverEntities->size());
+        Iterator begin() const {
+            return Iterator(m_reg, m_pools, m_filters, m_driverEntities, 0, driverSize());
         }
 
-        Iterator end() {
-            if (!m_valid) {
-                static const std::vector<Entity> empty;
-                return Iterator(m_reg, empty, 0, 0);
-            }
-            return Iterator(m_reg, *m_driverEntities, m_driverEntities->size(), m_driverEntities->size());
+        Iterator end() const {
+            return Iterator(m_reg, m_pools, m_filters, m_driverEntities, driverSize(), driverSize());
         }
 
         bool valid() const { return m_valid; }
 
+        /// Fast path: llama fn(Entity, Ts&...) o fn(Ts&...) por cada entidad
+        /// que tenga todos los componentes. El componente del driver se lee
+        /// por indice denso; el resto con un solo lookup de sparse cada uno.
+        ///
+        /// No crear/destruir entidades ni agregar/quitar componentes de Ts
+        /// desde fn: invalida los dense arrays que se estan recorriendo.
+        template <typename Fn>
+        void each(Fn&& fn) const {
+            if (!m_valid) return;
+            eachDispatch(fn, 0, m_driverEntities->size(), std::index_sequence_for<Ts...>{});
+        }
+
+        /// Como each(), pero parte el dense array del driver en rangos de
+        /// grainSize entidades y los procesa en paralelo en el JobSystem de
+        /// reg.ctx().jobs (sin job system corre secuencial).
+        ///
+        /// fn se llama concurrentemente: solo puede tocar los componentes de
+        /// la entidad que recibe. Mientras dura, el registry queda bloqueado
+        /// para cambios estructurales (create/destroy/emplace de un tipo
+        /// nuevo/remove/clear asertan).
+        template <typename Fn>
+        void parallelEach(Fn&& fn, size_t grainSize = DefaultGrainSize) const {
+            if (!m_valid) return;
+            StructureLock lock(*m_reg);
+            const size_t n = m_driverEntities->size();
+            JobSystem* jobs = m_reg->ctx().jobs;
+            if (!jobs) {
+                eachDispatch(fn, 0, n, std::index_sequence_for<Ts...>{});
+                return;
+            }
+            const ChunkContext context;
+            jobs->parallelFor(n, grainSize, [&](size_t begin, size_t end) {
+                ChunkScope scope(context);
+                eachDispatch(fn, begin, end, std::index_sequence_for<Ts...>{});
+            });
+        }
+
     private:
+        size_t driverSize() const {
+            return m_valid ? m_driverEntities->size() : 0;
+        }
+
+        /// Posicion de T en Ts (ignorando const).
+        template <typename T>
+        static constexpr size_t indexOf() {
+            constexpr bool same[] = {
+                std::is_same_v<std::remove_const_t<T>, std::remove_const_t<Ts>>... };
+            size_t i = 0;
+            while (i < sizeof...(Ts) && !same[i]) ++i;
+            static_assert(((std::is_same_v<std::remove_const_t<T>, std::remove_const_t<Ts>>) || ...),
+                "Change filters only apply to the view's own component types.");
+            return i;
+        }
+
+        template <size_t... Is>
+        static bool resolveAll(const Pools& pools, Entity e, Indices& idx, std::index_sequence<Is...>) {
+            return ((idx[Is] = std::get<Is>(pools)->denseIndex(e),
+                     idx[Is] != IComponentPool::InvalidDense) && ...);
+        }
+
+        template <size_t... Is>
+        static bool passesFilters(const Registry& reg, const Pools& pools, const Filters& f,
+                                  Entity e, const Indices& idx, std::index_sequence<Is...>) {
+            if (f.hasExcluded && reg.m_slots[e.index].mask.intersects(f.excluded)) return false;
+            if (!f.slice.contains(e)) return false;
+            return ((!((f.changedMask >> Is) & 1u) ||
+                     tickNewer(std::get<Is>(pools)->changedTick(idx[Is]), f.changedSince[Is])) && ...) &&
+                   ((!((f.addedMask >> Is) & 1u) ||
+                     tickNewer(std::get<Is>(pools)->addedTick(idx[Is]), f.addedSince[Is])) && ...);
+        }
+
+        /// Acceso mutable = modificacion: marca el tick del tipo I si no es const.
+        template <size_t I>
+        static void markIfMutable(const Pools& pools, uint32_t dense) {
+            if constexpr (!std::is_const_v<std::tuple_element_t<I, std::tuple<Ts...>>>) {
+                std::get<I>(pools)->markChanged(dense);
+            } else {
+                (void)pools;
+                (void)dense;
+            }
+        }
+
+        template <typename Fn, size_t... Is>
+        void eachDispatch(Fn& fn, size_t begin, size_t end, std::index_sequence<Is...> seq) const {
+            // El driver se elige en runtime: instanciamos un loop por cada
+            // candidato y saltamos al que corresponde.
+            ((m_driverIndex == Is ? (eachWithDriver<Is>(fn, begin, end, seq), true) : false) || ...);
+        }
+
+        /// Recorre [begin, end) del dense array del driver.
+        template <size_t Driver, typename Fn, size_t... Is>
+        void eachWithDriver(Fn& fn, size_t begin, size_t end, std::index_sequence<Is...> seq) const {
+            const std::vector<Entity>& entities = std::get<Driver>(m_pools)->denseEntities();
+            const bool filtered = m_filters.any();
+
+            for (size_t i = begin; i < end; ++i) {
+                const Entity e = entities[i];
+
+                Indices idx{};
+                const bool all = (resolveIndex<Is, Driver>(e, i, idx[Is]) && ...);
+                if (!all) continue;
+                if (filtered && !passesFilters(*m_reg, m_pools, m_filters, e, idx, seq)) continue;
+
+                (markIfMutable<Is>(m_pools, idx[Is]), ...);
+
+                invokeEach<Fn, Ts...>(fn, e, std::get<Is>(m_pools)->denseComponents()[idx[Is]]...);
+            }
+        }
+
+        /// Indice denso de e en el pool I. Para el driver ya lo conocemos (i).
+        template <size_t I, size_t Driver>
+        bool resolveIndex(Entity e, size_t driverIdx, uint32_t& out) const {
+            if constexpr (I == Driver) {
+                out = static_cast<uint32_t>(driverIdx);
+                return true;
+            } else {
+                auto* pool = std::get<I>(m_pools);
+                out = pool->denseIndex(e);
+                return out != pool->InvalidDense;
+            }
+        }
+
         void pickDriverPool() {
             // Si falta cualquiera de los pools, la view es vacía.
-            if (!allPoolsExist()) {
+            if (!allPoolsExist(std::index_sequence_for<Ts...>{})) {
                 m_valid = false;
                 return;
             }
 
             // Elegir el pool con menor size() como driver.
-            // Necesitamos obtener los denseEntities() del pool driver.
             size_t bestSize = std::numeric_limits<size_t>::max();
-            pickDriverImpl<Ts...>(bestSize);
+            pickDriverImpl(bestSize, std::index_sequence_for<Ts...>{});
 
             m_valid = (m_driverEntities != nullptr);
         }
 
-        bool allPoolsExist() {
-            return ((m_reg.poolOrNull<Ts>() != nullptr) && ...);
+        template <size_t... Is>
+        bool allPoolsExist(std::index_sequence<Is...>) const {
+            return ((std::get<Is>(m_pools) != nullptr) && ...);
         }
 
-        template <typename T>
+        template <size_t... Is>
+        void pickDriverImpl(size_t& bestSize, std::index_sequence<Is...>) {
+            (considerDriver<Is>(bestSize), ...);
+        }
+
+        template <size_t I>
         void considerDriver(size_t& bestSize) {
-            auto* p = m_reg.poolOrNull<T>();
-            if (!p) return;
+            auto* p = std::get<I>(m_pools);
             size_t s = p->size();
             if (s < bestSize) {
                 bestSize = s;
+                m_driverIndex = I;
                 m_driverEntities = &p->denseEntities();
             }
         }
 
-        template <typename T0, typename... Rest>
-        void pickDriverImpl(size_t& bestSize) {
-            considerDriver<T0>(bestSize);
-            if constexpr (sizeof...(Rest) > 0) {
-                pickDriverImpl<Rest...>(bestSize);
-            }
-        }
-
     private:
-        Registry& m_reg;
+        Registry* m_reg;
+        Pools m_pools;
+        Filters m_filters;
         bool m_valid = false;
+        size_t m_driverIndex = 0;
         const std::vector<Entity>* m_driverEntities = nullptr;
     };
 
     template <typename... Ts>
     View<Ts...> view() {
+        (checkAccess<Ts>(), ...);
         return View<Ts...>(*this);
     }
 
+    /// Owning group (estilo EnTT): mantiene a las entidades que tienen TODOS
+    /// los componentes Ts empaquetadas al frente de cada pool, en el mismo
+    /// orden. La posicion i de cada dense array corresponde a la misma
+    /// entidad para i < size(), asi que iterar es recorrer arrays paralelos
+    /// linealmente, sin ningun lookup de sparse.
+    ///
+    /// El grupo es dueño de sus pools: un pool solo puede pertenecer a un
+    /// grupo. La membresia se mantiene sola en emplace/remove/destroy.
+    ///
+    /// Igual que en View, los tipos no-const se marcan como modificados
+    /// (todo el rango recorrido) y los const solo se leen. Con slice()
+    /// each/parallelEach solo procesan y marcan las entidades del slice.
+    template <typename... Ts>
+    class Group {
+        using Pools = std::tuple<PoolFor<Ts>*...>;
+
+    public:
+        Group(Registry& reg, const GroupData& data, PoolFor<Ts>*... pools)
+            : m_reg(&reg), m_data(&data), m_pools(pools...) {}
+
+        /// Cantidad de entidades empaquetadas (las que tienen todos los Ts).
+        size_t size() const { return m_data->size; }
+        bool empty() const { return size() == 0; }
+
+        /// Entidad en la posicion i del grupo (i < size()).
+        Entity entity(size_t i) const {
+            return std::get<0>(m_pools)->denseEntities()[i];
+        }
+
+        /// Solo las entidades de part en each/parallelEach (ver TimeSlice).
+        /// Sin argumento, el slice del sistema que corre (reg.timeSlice()).
+        Group& slice(TimeSlice part) & {
+            m_slice = part;
+            return *this;
+        }
+        Group slice(TimeSlice part) && { return std::move(slice(part)); }
+        Group& slice() & { return slice(m_reg->timeSlice()); }
+        Group slice() && { return std::move(slice(m_reg->timeSlice())); }
+
+        /// Llama fn(Entity, Ts&...) o fn(Ts&...) por cada entidad del grupo.
+        /// Misma regla que View::each: nada de cambios estructurales en fn.
+        template <typename Fn>
+        void each(Fn&& fn) const {
+            eachImpl(fn, 0, size(), std::index_sequence_for<Ts...>{});
+        }
+
+        /// Version paralela de each(): mismas reglas que View::parallelEach.
+        template <typename Fn>
+        void parallelEach(Fn&& fn, size_t grainSize = DefaultGrainSize) const {
+            StructureLock lock(*m_reg);
+            JobSystem* jobs = m_reg->ctx().jobs;
+            if (!jobs) {
+                eachImpl(fn, 0, size(), std::index_sequence_for<Ts...>{});
+                return;
+            }
+            const ChunkContext context;
+            jobs->parallelFor(size(), grainSize, [&](size_t begin, size_t end) {
+                ChunkScope scope(context);
+                eachImpl(fn, begin, end, std::index_sequence_for<Ts...>{});
+            });
+        }
+
+        class Iterator {
+        public:
+            Iterator(const Pools& pools, size_t i) : m_pools(pools), m_i(i) {}
+
+            Iterator& operator++() { ++m_i; return *this; }
+            bool operator!=(const Iterator& other) const { return m_i != other.m_i; }
+
+            auto operator*() const {
+                return deref(std::index_sequence_for<Ts...>{});
+            }
+
+        private:
+            template <size_t... Is>
+            auto deref(std::index_sequence<Is...>) const {
+                const uint32_t i = static_cast<uint32_t>(m_i);
+                (markIfMutable<Is>(m_pools, i, i + 1), ...);
+                return std::tuple<Entity, Ts&...>(
+                    std::get<0>(m_pools)->denseEntities()[m_i],
+                    std::get<Is>(m_pools)->denseComponents()[m_i]...);
+            }
+
+            Pools m_pools;
+            size_t m_i = 0;
+        };
+
+        Iterator begin() const { return Iterator(m_pools, 0); }
+        Iterator end() const { return Iterator(m_pools, size()); }
+
+    private:
+        template <size_t I>
+        static void markIfMutable(const Pools& pools, uint32_t begin, uint32_t end) {
+            if constexpr (!std::is_const_v<std::tuple_element_t<I, std::tuple<Ts...>>>) {
+                std::get<I>(pools)->markChanged(begin, end);
+            } else {
+                (void)pools;
+                (void)begin;
+                (void)end;
+            }
+        }
+
+        template <typename Fn, size_t... Is>
+        void eachImpl(Fn& fn, size_t begin, size_t end, std::index_sequence<Is...>) const {
+            const Entity* entities = std::get<0>(m_pools)->denseEntities().data();
+            // Punteros crudos a cada dense array: el loop queda como un
+            // recorrido de arrays paralelos que el compilador puede optimizar.
+            auto arrays = std::make_tuple(std::get<Is>(m_pools)->denseComponents().data()...);
+
+            if (!m_slice.all()) {
+                // El slice es por indice de entidad, no contiguo: solo se lee
+                // el array de entidades para saltear; los componentes, el
+                // callback y la marca son solo de las del slice.
+                for (size_t i = begin; i < end; ++i) {
+                    if (!m_slice.contains(entities[i])) continue;
+                    const uint32_t dense = static_cast<uint32_t>(i);
+                    (markIfMutable<Is>(m_pools, dense, dense + 1), ...);
+                    invokeEach<Fn, Ts...>(fn, entities[i], std::get<Is>(arrays)[i]...);
+                }
+                return;
+            }
+
+            // Marcar el rango entero de una vez (un fill por tipo mutable)
+            // en vez de un store por entidad dentro del loop.
+            (markIfMutable<Is>(m_pools, static_cast<uint32_t>(begin), static_cast<uint32_t>(end)), ...);
+
+            for (size_t i = begin; i < end; ++i) {
+                invokeEach<Fn, Ts...>(fn, entities[i], std::get<Is>(arrays)[i]...);
+            }
+        }
+
+        Registry* m_reg;
+        const GroupData* m_data;
+        Pools m_pools;
+        TimeSlice m_slice;
+    };
+
+    /// Obtiene (o crea la primera vez) el owning group de Ts.
+    /// Crear el grupo reordena los pools para empaquetar a las entidades
+    /// que ya tienen todos los componentes. group<A, B>() y group<B, A>()
+    /// son el mismo grupo.
+    template <typename... Ts>
+    Group<Ts...> group() {
+        static_assert(sizeof...(Ts) > 0, "Group needs at least one component type.");
+        (checkAccess<Ts>(), ...);
+        (getOrCreatePool<std::remove_const_t<Ts>>(), ...);
+        const GroupData& data = acquireGroup({componentTypeId<Ts>()...});
+        return Group<Ts...>(*this, data, tryGetPool<std::remove_const_t<Ts>>()...);
+    }
+
+    /// Movimiento en layout SoA (opt-in, ver SoAMotion.h). Las entidades
+    /// agregadas aca las integra MovementSystem con el kernel SIMD; destroy()
+    /// las saca automaticamente.
+    SoAMotionPool&       motion()       { checkAccess<SoAMotionPool>(); return m_motion; }
+    const SoAMotionPool& motion() const { checkAccess<const SoAMotionPool>(); return m_motion; }
+
 private:
     struct Slot {
         uint32_t generation = 0;
         bool alive = false;
+        ComponentMask mask; // tipos de componente que tiene la entidad
     };
 
     EngineContext m_ctx;
@@ -219,39 +918,145 @@ private:
     std::vector<uint32_t> m_freeList;
     size_t m_aliveCount = 0;
 
-    std::unordered_map<std::type_index, std::unique_ptr<IComponentPool>> m_pools;
+    // Pools indexados por ComponentTypeId (ver ComponentType.h).
+    // Acceso O(1) por indice, sin hashing. Un slot nullptr = ese tipo
+    // todavia no tiene pool en este registry.
+    std::vector<std::unique_ptr<IComponentPool>> m_pools;
+
+    SoAMotionPool m_motion;
+
+    // parallelEach() anidados/concurrentes en curso. Atomico: con el
+    // JobSystem una iteracion paralela puede lanzarse desde un job.
+    std::atomic<uint32_t> m_structureLocks{0};
+
+    // Change tracking. Arranca en 1 para que todo lo creado antes de la
+    // primera corrida de un sistema (lastRunTick = 0) cuente como nuevo.
+    std::atomic<uint32_t> m_tick{1};
+    uint32_t m_lastRunTick = 0;
+    TimeSlice m_timeSlice;
+
+    // Validacion de accesos del SystemScheduler (ver SystemAccess.h): solo
+    // hace algo si el thread tiene un AccessGuard. Los tipos const y los
+    // vacios (tags, solo membresia) cuentan como lectura.
+    template <typename T>
+    void checkAccess() const {
+#ifndef NDEBUG
+        if (const detail::AccessGuard* guard = detail::t_accessGuard) {
+            using U = std::remove_const_t<T>;
+            guard->check(componentTypeId<U>(), !std::is_const_v<T> && !std::is_empty_v<U>, typeid(U).name());
+        }
+#endif
+    }
+
+    void checkStructural([[maybe_unused]] const char* what) const {
+#ifndef NDEBUG
+        if (const detail::AccessGuard* guard = detail::t_accessGuard) guard->structural(what);
+#endif
+    }
+
+    // Lo que los chunks de parallelEach heredan del sistema que los lanzo:
+    // su AccessGuard y su WriteTick son thread_local, y los chunks corren
+    // en otros workers.
+    struct ChunkContext {
+        const detail::AccessGuard* guard = detail::t_accessGuard;
+        detail::WriteTick writeTick = detail::t_writeTick;
+    };
+
+    struct ChunkScope {
+        explicit ChunkScope(const ChunkContext& context) : guard(context.guard), writeTick(context.writeTick) {}
+        detail::AccessGuardScope guard;
+        detail::WriteTickScope writeTick;
+    };
+
+    struct StructureLock {
+        explicit StructureLock(Registry& reg) : m_reg(reg) { m_reg.m_structureLocks++; }
+        ~StructureLock() { m_reg.m_structureLocks--; }
+        StructureLock(const StructureLock&) = delete;
+        StructureLock& operator=(const StructureLock&) = delete;
+        Registry& m_reg;
+    };
 
     template <typename T>
     ComponentPool<T>* getOrCreatePool() {
-        std::type_index key(typeid(T));
-        auto it = m_pools.find(key);
-        if (it == m_pools.end()) {
+        const ComponentTypeId id = componentTypeId<T>();
+        assert(id < MaxComponentTypes && "Too many component types: raise MaxComponentTypes!");
+        if (id >= m_pools.size()) {
+            assert(!structureLocked() && "Structural change during parallelEach!");
+            assert(!inParallelSystem() && "Pool created by a system running in parallel!");
+            m_pools.resize(id + 1);
+        }
+        auto& slot = m_pools[id];
+        if (!slot) {
+            assert(!structureLocked() && "Structural change during parallelEach!");
+            assert(!inParallelSystem() && "Pool created by a system running in parallel!");
             auto pool = std::make_unique<ComponentPool<T>>();
-            ComponentPool<T>* raw = pool.get();
-            m_pools.emplace(key, std::move(pool));
-            return raw;
+            pool->setTickSource(&m_tick);
+            slot = std::move(pool);
         }
-        return static_cast<ComponentPool<T>*>(it->second.get());
+        return static_cast<ComponentPool<T>*>(slot.get());
     }
 
     template <typename T>
     ComponentPool<T>* tryGetPool() {
-        std::type_index key(typeid(T));
-        auto it = m_pools.find(key);
-        if (it == m_pools.end()) return nullptr;
-        return static_cast<ComponentPool<T>*>(it->second.get());
+        const ComponentTypeId id = componentTypeId<T>();
+        if (id >= m_pools.size()) return nullptr;
+        return static_cast<ComponentPool<T>*>(m_pools[id].get());
     }
 
     template <typename T>
     const ComponentPool<T>* tryGetPoolConst() const {
-        std::type_index key(typeid(T));
-        auto it = m_pools.find(key);
-        if (it == m_pools.end()) return nullptr;
-        return static_cast<const ComponentPool<T>*>(it->second.get());
+        const ComponentTypeId id = componentTypeId<T>();
+        if (id >= m_pools.size()) return nullptr;
+        return static_cast<const ComponentPool<T>*>(m_pools[id].get());
     }
 
     void removeAllComponents(Entity e);
 
+    template <typename T, typename ValueAt>
+    void emplaceRangeImpl(std::span<const Entity> entities, ValueAt&& valueAt) {
+        checkAccess<T>();
+        checkStructural("emplaceRange");
+        auto* pool = getOrCreatePool<T>();
+        GroupData* owner = ownerOf<T>();
+        const ComponentTypeId id = componentTypeId<T>();
+        pool->reserve(pool->size() + entities.size());
+
+        for (size_t i = 0; i < entities.size(); ++i) {
+            const Entity e = entities[i];
+            assert(isAlive(e));
+            if (pool->has(e)) {
+                pool->emplace(e, valueAt(i)); // reasigna y marca changed
+                continue;
+            }
+            assert(!structureLocked() && "Structural change during parallelEach!");
+            m_slots[e.index].mask.set(id);
+            pool->emplace(e, valueAt(i));
+            if (owner) groupTryAdd(*owner, e);
+        }
+    }
+
+    // ── Owning groups ──
+    struct GroupData {
+        std::vector<ComponentTypeId> owned; // ordenados (para comparar sets)
+        size_t size = 0;                    // entidades empaquetadas al frente
+    };
+
+    // unique_ptr: los Group<Ts...> guardan un puntero a su GroupData,
+    // que tiene que sobrevivir a que m_groups crezca.
+    std::vector<std::unique_ptr<GroupData>> m_groups;
+    std::vector<GroupData*> m_poolOwner; // [ComponentTypeId] -> grupo dueño
+
+    template <typename T>
+    GroupData* ownerOf() const {
+        const ComponentTypeId id = componentTypeId<T>();
+        return id < m_poolOwner.size() ? m_poolOwner[id] : nullptr;
+    }
+
+    const GroupData& acquireGroup(std::vector<ComponentTypeId> owned);
+    void groupTryAdd(GroupData& g, Entity e);
+    void groupRemove(GroupData& g, Entity e);
+    void groupSwap(GroupData& g, uint32_t a, uint32_t b); // swapDense en todos los pools del grupo
+
     template <typename T>
     ComponentPool<T>* poolOrNull() {
         return tryGetPool<T>();
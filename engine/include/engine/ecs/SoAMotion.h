@@ -0,0 +1,181 @@
+#pragma once
+#include "engine/ecs/Entity.h"
+
+#include <glm/vec2.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+
+namespace eng::ecs {
+
+// ────────────────────────────────────────────────────────────────
+// Movimiento en layout SoA (opt-in)
+// ────────────────────────────────────────────────────────────────
+//
+// Transform2D/Velocity2D viven en pools AoS porque get<T>() devuelve T& y
+// el resto del engine (colision, camara, gameplay) trabaja con esa forma.
+// Para poblaciones grandes que solo se mueven (multitudes, particulas,
+// proyectiles) SoAMotionPool guarda lo mismo en arrays separados de
+// floats (x, y, prevX, prevY, vx, vy), que es lo que necesita el kernel
+// SIMD de integrateMotion().
+//
+// Una entidad usa UNA de las dos representaciones: o Transform2D +
+// Velocity2D, o el SoAMotionPool del registry (reg.motion()). MovementSystem
+// integra ambas y RenderSystem dibuja las entidades SoA que tengan Sprite.
+
+/// Vista cruda de los arrays SoA para el kernel de integracion.
+struct MotionStreams {
+    float*       x = nullptr;
+    float*       y = nullptr;
+    float*       prevX = nullptr;
+    float*       prevY = nullptr;
+    const float* vx = nullptr;
+    const float* vy = nullptr;
+    size_t       count = 0;
+
+    /// Sub-rango [begin, end) (para repartir el stream entre threads).
+    MotionStreams slice(size_t begin, size_t end) const {
+        return MotionStreams{x + begin, y + begin, prevX + begin, prevY + begin,
+                             vx + begin, vy + begin, end - begin};
+    }
+};
+
+/// prev = pos; pos += vel * dt para todo el stream.
+/// Usa AVX2 (8 entidades por iteracion) si el engine se compila con
+/// ENGINE_ENABLE_AVX2, SSE2 (4) en x86-64 y un loop escalar para el resto.
+/// Todos los caminos dan exactamente el mismo resultado (sin FMA).
+void integrateMotion(const MotionStreams& s, float dt);
+
+/// Nombre del camino SIMD compilado ("AVX2", "SSE2" o "scalar").
+const char* motionKernelName();
+
+/// Sparse set de entidades con movimiento en SoA. Mismo esquema que
+/// ComponentPool (sparse -> dense + swap-remove), pero con un array por
+/// campo en vez de un std::vector<T>.
+class SoAMotionPool {
+public:
+    static constexpr uint32_t InvalidDense = 0xFFFFFFFFu;
+
+    void add(Entity e, glm::vec2 position, glm::vec2 velocity = {0.0f, 0.0f}) {
+        assert(e.isValid());
+        if (has(e)) {
+            const uint32_t i = m_sparse[e.index];
+            m_x[i] = m_prevX[i] = position.x;
+            m_y[i] = m_prevY[i] = position.y;
+            m_vx[i] = velocity.x;
+            m_vy[i] = velocity.y;
+            return;
+        }
+
+        if (e.index >= m_sparse.size()) {
+            m_sparse.resize(static_cast<size_t>(e.index) + 1, InvalidDense);
+        }
+        m_sparse[e.index] = static_cast<uint32_t>(m_entities.size());
+        m_entities.push_back(e);
+        m_x.push_back(position.x);
+        m_y.push_back(position.y);
+        m_prevX.push_back(position.x);
+        m_prevY.push_back(position.y);
+        m_vx.push_back(velocity.x);
+        m_vy.push_back(velocity.y);
+    }
+
+    void remove(Entity e) {
+        if (!has(e)) return;
+
+        const uint32_t i = m_sparse[e.index];
+        const uint32_t last = static_cast<uint32_t>(m_entities.size() - 1);
+        if (i != last) {
+            m_entities[i] = m_entities[last];
+            m_x[i] = m_x[last];
+            m_y[i] = m_y[last];
+            m_prevX[i] = m_prevX[last];
+            m_prevY[i] = m_prevY[last];
+            m_vx[i] = m_vx[last];
+            m_vy[i] = m_vy[last];
+            m_sparse[m_entities[i].index] = i;
+        }
+        m_entities.pop_back();
+        m_x.pop_back();
+        m_y.pop_back();
+        m_prevX.pop_back();
+        m_prevY.pop_back();
+        m_vx.pop_back();
+        m_vy.pop_back();
+        m_sparse[e.index] = InvalidDense;
+    }
+
+    bool has(Entity e) const {
+        if (e.index >= m_sparse.size()) return false;
+        const uint32_t i = m_sparse[e.index];
+        return i != InvalidDense && m_entities[i].generation == e.generation;
+    }
+
+    size_t size() const { return m_entities.size(); }
+
+    void clear() {
+        m_sparse.clear();
+        m_entities.clear();
+        m_x.clear();
+        m_y.clear();
+        m_prevX.clear();
+        m_prevY.clear();
+        m_vx.clear();
+        m_vy.clear();
+    }
+
+    void reserve(size_t n) {
+        m_entities.reserve(n);
+        m_x.reserve(n);
+        m_y.reserve(n);
+        m_prevX.reserve(n);
+        m_prevY.reserve(n);
+        m_vx.reserve(n);
+        m_vy.reserve(n);
+    }
+
+    // ── Acceso por entidad ──
+    glm::vec2 position(Entity e) const     { const uint32_t i = denseOf(e); return {m_x[i], m_y[i]}; }
+    glm::vec2 prevPosition(Entity e) const { const uint32_t i = denseOf(e); return {m_prevX[i], m_prevY[i]}; }
+    glm::vec2 velocity(Entity e) const     { const uint32_t i = denseOf(e); return {m_vx[i], m_vy[i]}; }
+
+    void setPosition(Entity e, glm::vec2 p) {
+        const uint32_t i = denseOf(e);
+        m_x[i] = p.x;
+        m_y[i] = p.y;
+    }
+
+    void setVelocity(Entity e, glm::vec2 v) {
+        const uint32_t i = denseOf(e);
+        m_vx[i] = v.x;
+        m_vy[i] = v.y;
+    }
+
+    // ── Acceso por indice denso (loops) ──
+    const std::vector<Entity>& entities() const { return m_entities; }
+    glm::vec2 positionAt(size_t i) const     { return {m_x[i], m_y[i]}; }
+    glm::vec2 prevPositionAt(size_t i) const { return {m_prevX[i], m_prevY[i]}; }
+
+    MotionStreams streams() {
+        return MotionStreams{m_x.data(), m_y.data(), m_prevX.data(), m_prevY.data(),
+                             m_vx.data(), m_vy.data(), m_entities.size()};
+    }
+
+    /// prev = pos; pos += vel * dt para todas las entidades del pool.
+    void integrate(float dt) { integrateMotion(streams(), dt); }
+
+private:
+    uint32_t denseOf(Entity e) const {
+        assert(has(e) && "Entity is not in the SoA motion pool!");
+        return m_sparse[e.index];
+    }
+
+    std::vector<uint32_t> m_sparse; // [entity.index] -> indice denso
+    std::vector<Entity>   m_entities;
+    std::vector<float>    m_x, m_y;
+    std::vector<float>    m_prevX, m_prevY;
+    std::vector<float>    m_vx, m_vy;
+};
+
+} // namespace eng::ecs
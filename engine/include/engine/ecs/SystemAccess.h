@@ -0,0 +1,164 @@
+#pragma once
+#include "engine/ecs/ComponentType.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace eng::ecs {
+
+/// Que tipos lee y escribe un sistema (se declara en addSystem). El
+/// SystemScheduler corre en paralelo a los sistemas de una misma fase que
+/// no chocan: ninguno escribe algo que el otro lee o escribe.
+///
+///   SystemAccess().read<Velocity2D, BoxCollision>().write<Transform2D>()
+///
+/// Los tipos pueden ser componentes o cualquier otro recurso que
+/// compartan los sistemas (Renderer2D, AnimationLibrary, SoAMotionPool,
+/// Input...): solo se usa su ComponentTypeId como identificador.
+///
+/// Un SystemAccess sin declarar (el default) choca con todo: el sistema
+/// corre solo, en su lugar por prioridad (igual que antes del scheduler
+/// paralelo). Es lo que corresponde a sistemas que tocan estado global
+/// sin declarar (ImGui, Input, Time).
+///
+/// Un sistema declarado no puede hacer cambios estructurales (create,
+/// destroy, emplace de un componente nuevo, remove): tiene que grabarlos
+/// en scheduler.commandBuffer().
+class SystemAccess {
+public:
+    template <typename... Ts>
+    SystemAccess read() const {
+        SystemAccess a = *this;
+        (a.m_reads.set(componentTypeId<Ts>()), ...);
+        a.m_declared = true;
+        return a;
+    }
+
+    template <typename... Ts>
+    SystemAccess write() const {
+        SystemAccess a = *this;
+        (a.m_writes.set(componentTypeId<Ts>()), ...);
+        a.m_declared = true;
+        return a;
+    }
+
+    /// Declarado sin ningun acceso (no choca con nadie).
+    static SystemAccess none() {
+        SystemAccess a;
+        a.m_declared = true;
+        return a;
+    }
+
+    bool declared() const { return m_declared; }
+    const ComponentMask& reads() const  { return m_reads; }
+    const ComponentMask& writes() const { return m_writes; }
+
+    bool canRead(ComponentTypeId id) const  { return m_reads.test(id) || m_writes.test(id); }
+    bool canWrite(ComponentTypeId id) const { return m_writes.test(id); }
+
+    /// true si los dos sistemas no pueden correr a la vez.
+    bool conflictsWith(const SystemAccess& other) const {
+        if (!m_declared || !other.m_declared) return true;
+        return m_writes.intersects(other.m_writes) ||
+               m_writes.intersects(other.m_reads) ||
+               m_reads.intersects(other.m_writes);
+    }
+
+private:
+    ComponentMask m_reads;
+    ComponentMask m_writes;
+    bool m_declared = false;
+};
+
+namespace detail {
+
+/// Lo ya reportado de un sistema (ver AccessGuard). Los chunks de
+/// parallelEach reportan a la vez desde varios threads: cada marca es un
+/// fetch_or/exchange y solo el thread que la prende imprime. La copia
+/// (System vive en un vector que se ordena) solo se usa sin sistemas
+/// corriendo.
+class ReportedAccess {
+public:
+    ReportedAccess() = default;
+    ReportedAccess(const ReportedAccess& other) { copyFrom(other); }
+    ReportedAccess& operator=(const ReportedAccess& other) {
+        copyFrom(other);
+        return *this;
+    }
+
+    /// true si id no estaba reportado (y lo deja marcado).
+    bool markRead(ComponentTypeId id)  { return markBit(m_reads, id); }
+    bool markWrite(ComponentTypeId id) { return markBit(m_writes, id); }
+    bool markStructural()              { return !m_structural.exchange(true, std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t Words = MaxComponentTypes / 64;
+    using Bits = std::array<std::atomic<uint64_t>, Words>;
+
+    static bool markBit(Bits& words, ComponentTypeId id) {
+        const uint64_t bit = uint64_t{1} << (id & 63);
+        return (words[id >> 6].fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+    }
+
+    void copyFrom(const ReportedAccess& other) {
+        for (size_t w = 0; w < Words; ++w) {
+            m_reads[w].store(other.m_reads[w].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            m_writes[w].store(other.m_writes[w].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        m_structural.store(other.m_structural.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    Bits m_reads{};
+    Bits m_writes{};
+    std::atomic<bool> m_structural{false};
+};
+
+/// Validacion de accesos (modo debug del SystemScheduler). Mientras corre
+/// un sistema declarado, su thread tiene un AccessGuard y el Registry le
+/// reporta cada tipo que toca (view, group, get, has, sort, motion...) y
+/// cada cambio estructural. Cada acceso no declarado se reporta una sola
+/// vez por sistema. Solo en builds con asserts (ver Registry::checkAccess).
+struct AccessGuard {
+    const char*            system = "";
+    const SystemAccess*    access = nullptr;
+    ReportedAccess*        reported = nullptr;   // del System: no repetir reportes
+    std::atomic<uint32_t>* violations = nullptr;
+
+    void check(ComponentTypeId id, bool write, const char* typeName) const {
+        if (write ? access->canWrite(id) : access->canRead(id)) return;
+        if (!(write ? reported->markWrite(id) : reported->markRead(id))) return;
+        violations->fetch_add(1, std::memory_order_relaxed);
+        std::fprintf(stderr, "[SystemScheduler] %s: undeclared %s of %s\n",
+                     system, write ? "write" : "read", typeName);
+    }
+
+    void structural(const char* what) const {
+        if (!reported->markStructural()) return;
+        violations->fetch_add(1, std::memory_order_relaxed);
+        std::fprintf(stderr, "[SystemScheduler] %s: structural change (%s) outside the command buffer\n",
+                     system, what);
+    }
+};
+
+/// Guard del sistema que corre en este thread (nullptr = sin validar).
+inline thread_local const AccessGuard* t_accessGuard = nullptr;
+
+/// Instala un guard para el thread actual mientras vive (anidable: un
+/// wait() del JobSystem puede correr otro sistema en el mismo thread).
+class AccessGuardScope {
+public:
+    explicit AccessGuardScope(const AccessGuard* guard) : m_prev(t_accessGuard) { t_accessGuard = guard; }
+    ~AccessGuardScope() { t_accessGuard = m_prev; }
+    AccessGuardScope(const AccessGuardScope&) = delete;
+    AccessGuardScope& operator=(const AccessGuardScope&) = delete;
+
+private:
+    const AccessGuard* m_prev;
+};
+
+} // namespace detail
+
+} // namespace eng::ecs
@@ -1,8 +1,13 @@
 #pragma once
 #include "engine/Profiling.h"
 #include "engine/ecs/Registry.h"
+#include "engine/ecs/CommandBuffer.h"
+#include "engine/ecs/SystemAccess.h"
 
+#include <array>
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -16,18 +21,44 @@ enum class Phase {
 
 struct System {
     std::string name;
-    Phase phase;
+    Phase phase = Phase::Update;
     int priority = 0;
     bool enabled = true;
     std::function<void(Registry&, float)> fn; // dt para Fixed/Update, alpha para Render si querés
+    uint32_t lastRunTick = 0; // tick de la ultima corrida (filtros changed/added)
+    bool warmedUp = false;    // ya corrio una vez en serie (ver SystemScheduler::runPhase)
+    SystemAccess access;      // reads/writes declarados (sin declarar = corre solo)
+    eng::Profiler::ZoneId zone = eng::Profiler::InvalidZone; // zona del profiler (su nombre)
+
+    // Frecuencia (SystemScheduler::setRate / setTimeSlices).
+    uint32_t rateDivisor = 1;            // corre 1 de cada N ticks de su fase
+    uint32_t sliceCount = 1;             // 1/N de las entidades por corrida
+    uint32_t skippedTicks = 0;           // ticks salteados desde la ultima corrida
+    float    skippedDt = 0.0f;           // dt acumulado de esos ticks
+    uint32_t nextSlice = 0;
+    std::vector<float>    sliceDt;       // [slice] dt desde que corrio ese slice
+    std::vector<uint32_t> sliceRunTick;  // [slice] lastRunTick de ese slice
+
+    // Corrida del tick actual (la decide runPhase antes de lanzar la fase).
+    bool      due = false;
+    float     runDt = 0.0f;
+    TimeSlice runSlice;
+
+    // Modo debug (setValidateAccess): lo ya reportado, para no repetirlo
+    // cada frame.
+    detail::ReportedAccess reported;
 };
 
 class SystemScheduler {
 public:
     explicit SystemScheduler(eng::Profiler& profiler)
-        : m_profiler(profiler) {}
+        : m_profiler(profiler), m_commandsZone(profiler.registerZone("CommandBuffer")) {}
 
-    void addSystem(std::string name, Phase phase, int priority, std::function<void(Registry&, float)> fn);
+    /// access declara que tipos lee y escribe el sistema (ver
+    /// SystemAccess). Los sistemas de una fase que no chocan corren en
+    /// paralelo; entre los que chocan se respeta el orden por prioridad.
+    void addSystem(std::string name, Phase phase, int priority, std::function<void(Registry&, float)> fn,
+                   SystemAccess access = {});
     void fixedUpdate(Registry& reg, float fixedDt);
     void update(Registry& reg, float dt);
     void render(Registry& reg, float alpha);
@@ -35,12 +66,90 @@ public:
     const std::vector<System>& systems() const { return m_systems; }
     bool setEnabled(const std::string& name, bool enabled);
     bool isEnabled(const std::string& name) const;
+
+    /// Correr el sistema 1 de cada divisor ticks de su fase (p.ej. IA a
+    /// 15 Hz con un FixedUpdate de 60 Hz = 4). Recibe el dt acumulado de
+    /// los ticks que salteo; los filtros changed/added ven todo lo
+    /// modificado desde su corrida anterior. En Render se le pasa alpha
+    /// tal cual (no se acumula).
+    bool setRate(const std::string& name, uint32_t divisor);
+
+    /// Time-slicing: el sistema corre cada tick (o cada rate ticks) pero
+    /// procesa 1/slices de sus entidades por corrida, en rotacion. Cada
+    /// corrida recibe el dt acumulado desde la ultima vez que proceso ese
+    /// mismo slice, y lastRunTick() es el de ese slice. El sistema tiene que
+    /// respetar reg.timeSlice(): view.slice() / group.slice() (solo tocan y
+    /// marcan las del slice) o TimeSlice::contains(e).
+    bool setTimeSlices(const std::string& name, uint32_t slices);
+
+    /// Correr en paralelo (en el JobSystem de reg.ctx().jobs) los sistemas
+    /// declarados de una fase que no chocan entre si. Sin job system, sin
+    /// workers o con esto apagado, todo corre en serie por prioridad.
+    /// Los sistemas sin declarar corren siempre en el thread que llama
+    /// (pueden usar GL/SDL/ImGui); los declarados pueden correr en
+    /// cualquier worker.
+    void setParallel(bool parallel) { m_parallel = parallel; }
+    bool parallel() const { return m_parallel; }
+
+    /// Modo debug: mientras corre cada sistema declarado, el Registry
+    /// reporta (stderr, una vez por sistema y tipo) los accesos a tipos no
+    /// declarados y los cambios estructurales fuera del command buffer.
+    /// Solo en builds con asserts.
+    void setValidateAccess(bool validate) { m_validateAccess = validate; }
+    bool validateAccess() const { return m_validateAccess; }
+    uint32_t accessViolations() const { return m_violations.load(std::memory_order_relaxed); }
+
+    /// CommandBuffer del thread actual. Lo grabado se aplica al terminar
+    /// la fase en curso (ver runPhase), en lote y ordenado.
+    CommandBuffer& commandBuffer() { return m_commands.local(); }
+    CommandQueue&  commands()      { return m_commands; }
 private:
+    /// Sistemas de una fase en orden de prioridad, partidos en segmentos:
+    /// cada sistema sin declarar es un segmento propio (corre solo, en el
+    /// thread que llama) y los declarados consecutivos forman un DAG:
+    /// arista i -> j si i va antes que j por prioridad y chocan.
+    struct Segment {
+        uint32_t begin = 0, end = 0; // rango de nodos
+        bool parallel = false;       // declarado y con algo que paralelizar
+    };
+
+    struct PhaseGraph {
+        std::vector<uint32_t> nodes;                      // [nodo] -> indice en m_systems
+        std::vector<Segment> segments;
+        std::vector<std::vector<uint32_t>> successors;    // [nodo] -> nodos del mismo segmento
+        std::vector<uint32_t> predecessorCount;           // [nodo]
+        std::unique_ptr<std::atomic<uint32_t>[]> pending; // predecesores sin terminar (corrida actual)
+    };
+
+    struct PhaseRun {
+        PhaseGraph* graph = nullptr;
+        Registry*   reg = nullptr;
+        JobSystem*  jobs = nullptr;
+        JobCounter  done;
+    };
+
     void runPhase(Phase phase, Registry& reg, float dtOrAlpha);
+    void runSerial(PhaseGraph& graph, uint32_t begin, uint32_t end, Registry& reg);
+    void runParallel(PhaseGraph& graph, const Segment& segment, Registry& reg, JobSystem& jobs);
+    void launchNode(PhaseRun& run, uint32_t node);
+    void runNode(PhaseRun& run, uint32_t node);
+    void invoke(System& s, Registry& reg);
+    void scheduleRun(System& s, Phase phase, float dtOrAlpha);
+    uint32_t beginRun(System& s, Registry& reg);
+    System* findSystem(const std::string& name);
+    void buildGraphs();
 
 private:
     eng::Profiler& m_profiler;
+    eng::Profiler::ZoneId m_commandsZone;
     std::vector<System> m_systems;
+    CommandQueue m_commands;
+
+    std::array<PhaseGraph, 3> m_graphs; // [Phase]
+    bool m_graphsDirty = true;
+    bool m_parallel = true;
+    bool m_validateAccess = false;
+    std::atomic<uint32_t> m_violations{0};
 };
 
 } // namespace eng::ecs
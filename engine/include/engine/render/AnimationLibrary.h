@@ -0,0 +1,112 @@
+#pragma once
+#include "engine/render/Texture.h"
+
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace eng {
+
+/// Handle a un set de clips del AnimationLibrary (indice estable).
+using ClipSetHandle = uint32_t;
+inline constexpr ClipSetHandle InvalidClipSet = 0xFFFFFFFFu;
+
+/// Clip de animacion: una secuencia de frames UV dentro de un sprite sheet.
+/// Cada frame es un Rect con las coordenadas UV de ese frame en la textura.
+/// Es la descripcion que se le pasa al AnimationLibrary; las entidades no
+/// guardan clips, solo un ClipSetHandle.
+struct AnimationClip {
+    std::string name;                 // "idle", "walk_down", etc.
+    std::vector<Rect> frames;         // UVs de cada frame
+    float frameDuration = 0.15f;      // segundos por frame (~6 FPS)
+    bool loop = true;                 // repetir al terminar?
+};
+
+/// Guarda los clips de animacion UNA vez para todas las entidades que los
+/// usan (antes cada SpriteAnimator tenia su propia copia de los clips, con
+/// strings y vectores de frames por entidad).
+///
+/// Un "clip set" es la lista de clips de un tipo de entidad (el player:
+/// idle/walk_down/walk_up/walk_side; una gallina: idle). Los frames de
+/// todos los clips viven en un solo array contiguo y cada clip es un rango
+/// de ese array, asi que AnimationSystem lee datos compactos.
+///
+/// Es del Engine y los sistemas lo ven via reg.ctx().animations. Se llena
+/// al cargar la escena; no agregar sets mientras corren los sistemas.
+class AnimationLibrary {
+public:
+    /// Un clip ya cargado: rango [firstFrame, firstFrame + frameCount) de frames().
+    struct Clip {
+        uint32_t firstFrame = 0;
+        uint32_t frameCount = 0;
+        float    frameDuration = 0.15f;
+        bool     loop = true;
+    };
+
+    /// Copia los clips al library y devuelve el handle del set.
+    ClipSetHandle addClipSet(std::span<const AnimationClip> clips);
+    ClipSetHandle addClipSet(std::initializer_list<AnimationClip> clips) {
+        return addClipSet(std::span<const AnimationClip>(clips.begin(), clips.size()));
+    }
+
+    bool valid(ClipSetHandle set) const { return set < m_sets.size(); }
+
+    uint32_t clipCount(ClipSetHandle set) const {
+        assert(valid(set));
+        return m_sets[set].clipCount;
+    }
+
+    const Clip& clip(ClipSetHandle set, uint32_t index) const {
+        assert(valid(set) && index < m_sets[set].clipCount);
+        return m_clips[m_sets[set].firstClip + index];
+    }
+
+    const Rect& frame(const Clip& clip, uint32_t index) const {
+        assert(index < clip.frameCount);
+        return m_frames[clip.firstFrame + index];
+    }
+
+    /// Indice del clip llamado name dentro del set, o -1 (no es para loops
+    /// calientes: compara strings).
+    int findClip(ClipSetHandle set, std::string_view name) const;
+
+    /// Frame de clip a los `elapsed` segundos de haber arrancado, en forma
+    /// cerrada: floor(elapsed / frameDuration), con wrap si el clip es loop
+    /// o clavado en el ultimo frame si no. Lo usa TimedSpriteAnimator.
+    static uint32_t frameIndexAt(const Clip& clip, double elapsed) {
+        assert(clip.frameCount > 0);
+        if (elapsed <= 0.0) return 0;
+        const uint64_t n = static_cast<uint64_t>(elapsed / clip.frameDuration);
+        if (clip.loop) return static_cast<uint32_t>(n % clip.frameCount);
+        return n < clip.frameCount ? static_cast<uint32_t>(n) : clip.frameCount - 1;
+    }
+
+    /// Reloj de animacion en segundos. Lo avanza AnimationSystem con el dt
+    /// de update; los TimedSpriteAnimator guardan su startTime en este reloj.
+    double now() const { return m_now; }
+    void advanceClock(float dt) { m_now += dt; }
+
+    size_t setCount() const   { return m_sets.size(); }
+    size_t clipCount() const  { return m_clips.size(); }
+    size_t frameCount() const { return m_frames.size(); }
+
+    void clear();
+
+private:
+    struct ClipSet {
+        uint32_t firstClip = 0;
+        uint32_t clipCount = 0;
+    };
+
+    std::vector<Rect>        m_frames;    // frames de todos los clips, contiguos
+    std::vector<Clip>        m_clips;     // clips de todos los sets, contiguos
+    std::vector<std::string> m_clipNames; // paralelo a m_clips (solo para findClip)
+    std::vector<ClipSet>     m_sets;      // [ClipSetHandle]
+    double                   m_now = 0.0;
+};
+
+} // namespace eng
@@ -0,0 +1,27 @@
+#pragma once
+#include "engine/render/RenderBackend.h"
+
+namespace eng {
+
+/// Backend OpenGL 3.3 de Renderer2D: shaders con multi-texture (hasta 16
+/// units), un VAO/VBO dinamico y un glDrawArrays por batch. Necesita el
+/// contexto GL activo en el thread que llama.
+class GLRenderBackend final : public RenderBackend {
+public:
+    void init() override;
+    void shutdown() override;
+    uint32_t whiteTexture() const override { return m_whiteTexture; }
+    void draw(const RenderBatch& batch) override;
+
+private:
+    uint32_t compileShader(uint32_t type, const char* src);
+    uint32_t linkProgram(uint32_t vs, uint32_t fs);
+
+    uint32_t m_whiteTexture = 0; // GL ID de la textura 1x1 blanca del renderer
+    uint32_t m_vao = 0;
+    uint32_t m_vbo = 0;
+    uint32_t m_program = 0;
+    int32_t  m_locScreenSize = -1;
+};
+
+} // namespace eng
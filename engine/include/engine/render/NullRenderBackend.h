@@ -0,0 +1,58 @@
+#pragma once
+#include "engine/render/RenderBackend.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eng {
+
+/// Backend sin API grafica: no dibuja nada, solo cuenta lo que recibe.
+/// Para correr Renderer2D y los sistemas de Render en maquinas headless
+/// (benchmarks, servidores, CI).
+///
+/// Con setCapture(true) ademas copia cada batch (vertices + texturas)
+/// para inspeccionarlo despues; reset() vacia lo grabado y los contadores.
+class NullRenderBackend final : public RenderBackend {
+public:
+    /// Un draw grabado: rango en vertices() y las texturas de sus units.
+    struct Draw {
+        uint32_t firstVertex = 0;
+        uint32_t vertexCount = 0;
+        std::array<uint32_t, 16> textures{};
+        int textureCount = 0;
+        int screenW = 1;
+        int screenH = 1;
+    };
+
+    /// Id de la textura blanca. Los ids de las demas texturas los inventa
+    /// quien arma la escena (p.ej. con TextureManager::add).
+    static constexpr uint32_t WhiteTexture = 1;
+
+    void init() override {}
+    void shutdown() override {}
+    uint32_t whiteTexture() const override { return WhiteTexture; }
+    void draw(const RenderBatch& batch) override;
+
+    void setCapture(bool capture) { m_capture = capture; }
+    bool capture() const { return m_capture; }
+    void reset();
+
+    uint64_t drawCount() const { return m_drawCount; }
+    uint64_t vertexCount() const { return m_vertexCount; }
+    uint64_t uploadBytes() const { return m_uploadBytes; }
+
+    const std::vector<Draw>& draws() const { return m_draws; }
+    const std::vector<Vertex2D>& vertices() const { return m_vertices; }
+
+private:
+    bool m_capture = false;
+    uint64_t m_drawCount = 0;
+    uint64_t m_vertexCount = 0;
+    uint64_t m_uploadBytes = 0;
+    std::vector<Draw> m_draws;
+    std::vector<Vertex2D> m_vertices;
+};
+
+} // namespace eng
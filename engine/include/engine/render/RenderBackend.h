@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+
+namespace eng {
+
+/// Vertice de los batches de Renderer2D (ya en pixeles de pantalla).
+struct Vertex2D {
+    float x, y;
+    float r, g, b, a;
+    float u, v;
+    int   texIndex;   // entero puro → viaja sin conversión float
+};
+
+/// Un flush de Renderer2D: triangulos (6 vertices por quad) y las
+/// texturas bindeadas a cada unit (textures[0] = la blanca).
+struct RenderBatch {
+    const Vertex2D* vertices = nullptr;
+    uint32_t vertexCount = 0;
+    const uint32_t* textures = nullptr;
+    int textureCount = 0;
+    int screenW = 1;
+    int screenH = 1;
+};
+
+/// Lo que Renderer2D necesita de la API grafica. Renderer2D arma los
+/// batches (slots de textura, transformacion a pixeles, pixel-snap) y el
+/// backend solo los dibuja, asi el costo de CPU del submit se puede medir
+/// sin contexto GL (NullRenderBackend).
+///
+/// - GLRenderBackend: OpenGL 3.3 (el default de Renderer2D).
+/// - NullRenderBackend: no dibuja; cuenta y opcionalmente graba los batches.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    /// Crea los recursos (programa, buffers, textura blanca). Idempotente.
+    virtual void init() = 0;
+    virtual void shutdown() = 0;
+
+    /// Id de la textura blanca 1x1 (slot 0 de cada batch, quads de color).
+    virtual uint32_t whiteTexture() const = 0;
+
+    /// Sube los vertices y dibuja el batch.
+    virtual void draw(const RenderBatch& batch) = 0;
+};
+
+} // namespace eng
@@ -0,0 +1,94 @@
+#pragma once
+#include "engine/Profiling.h"
+#include "engine/render/RenderSnapshot.h"
+
+#include <SDL.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+struct ImDrawData;
+struct ImDrawList;
+
+namespace eng {
+
+class Renderer2D;
+
+/// Un frame extraido por el main thread para el render thread: lo que
+/// grabaron los sistemas de Render + una copia de la draw data de ImGui.
+struct FrameSnapshot {
+    RenderSnapshot render;
+    int drawableW = 1, drawableH = 1;
+
+    // ImGui (CloneOutput de cada ImDrawList: la draw data original se
+    // invalida en el proximo ImGui::NewFrame del main thread).
+    std::vector<ImDrawList*> uiLists;
+    float uiDisplayPos[2] = {0.0f, 0.0f};
+    float uiDisplaySize[2] = {0.0f, 0.0f};
+    float uiFramebufferScale[2] = {1.0f, 1.0f};
+
+    FrameSnapshot() = default;
+    ~FrameSnapshot();
+    FrameSnapshot(const FrameSnapshot&) = delete;
+    FrameSnapshot& operator=(const FrameSnapshot&) = delete;
+
+    void captureUi(const ImDrawData* drawData);
+    void clearUi();
+};
+
+/// Render pipelined (EngineConfig::pipelinedRender): el main thread
+/// simula y extrae el frame N+1 mientras un render thread dibuja el frame
+/// N y espera el vsync en SDL_GL_SwapWindow.
+///
+/// - El render thread es dueno del contexto GL mientras el pipeline vive
+///   (el constructor lo suelta en el thread que llama y el destructor se
+///   lo devuelve). Nada fuera del render thread puede tocar GL en ese
+///   tiempo: texturas y shaders se cargan antes de Engine::run().
+/// - Tres FrameSnapshot: uno lo escribe el main thread, otro lo dibuja el
+///   render thread y el tercero es el buzon entre los dos. El traspaso es
+///   un exchange atomico del indice del buzon (sin locks); para esperar
+///   se usa wait/notify del mismo atomico.
+/// - publish() espera a que el render thread tome el frame publicado: el
+///   main thread va a lo sumo un frame adelantado y nunca se descartan
+///   frames.
+class RenderPipeline {
+public:
+    /// Lo que tarda el render thread en dibujar cada frame (replay + ImGui
+    /// + swap) va a la zona "RenderThread" de profiler.
+    RenderPipeline(SDL_Window* window, SDL_GLContext context, Renderer2D& renderer, Profiler& profiler);
+    ~RenderPipeline();
+
+    RenderPipeline(const RenderPipeline&) = delete;
+    RenderPipeline& operator=(const RenderPipeline&) = delete;
+
+    /// Snapshot que escribe el main thread para el proximo publish().
+    FrameSnapshot& frame() { return m_frames[m_writeSlot]; }
+
+    /// Entrega frame() al render thread y pasa a escribir otro slot.
+    void publish();
+
+private:
+    static constexpr uint32_t SlotMask  = 0x3;
+    static constexpr uint32_t FreshBit  = 0x4; // el buzon tiene un frame sin tomar
+    static constexpr uint32_t StopBit   = 0x8;
+
+    void renderLoop();
+    void draw(FrameSnapshot& frame);
+
+    SDL_Window*   m_window;
+    SDL_GLContext m_context;
+    Renderer2D&   m_renderer;
+    Profiler&     m_profiler;
+    Profiler::ZoneId m_zone;
+
+    std::array<FrameSnapshot, 3> m_frames;
+    uint32_t m_writeSlot = 0;              // solo el main thread
+    uint32_t m_readSlot = 1;               // solo el render thread
+    std::atomic<uint32_t> m_mailbox{2};    // slot | FreshBit | StopBit
+    std::thread m_thread;
+};
+
+} // namespace eng
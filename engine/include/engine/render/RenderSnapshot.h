@@ -0,0 +1,92 @@
+#pragma once
+#include "engine/ecs/Components.h"
+#include "engine/render/Texture.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace eng {
+
+/// Lo que se le pidio a un Renderer2D durante un frame, grabado en vez de
+/// dibujado (Renderer2D::beginRecording). Es el estado inmutable que el
+/// render thread consume en el modo pipelined (ver RenderPipeline):
+/// sprites, tiles y camara ya resueltos por los sistemas de Render, en el
+/// orden en que se submitieron. Renderer2D::replay() lo dibuja.
+///
+/// Solo datos planos: se reusa entre frames (clear() conserva la
+/// capacidad de los vectores).
+struct RenderSnapshot {
+    enum class Op : uint8_t {
+        BeginFrame,
+        SetCamera,
+        Quads,
+        Flush,
+        EndFrame
+    };
+
+    struct Command {
+        Op op = Op::Flush;
+        int screenW = 0, screenH = 0;     // BeginFrame
+        glm::vec2 camCenter{0.0f, 0.0f};  // SetCamera
+        float ppu = 0.0f;
+        uint32_t first = 0, count = 0;    // Quads: rango en quads
+    };
+
+    struct Quad {
+        glm::vec2 center{0.0f, 0.0f};
+        float w = 0.0f, h = 0.0f;
+        uint32_t glTexId = 0;
+        Rect uv;
+        ecs::Color4 tint;
+    };
+
+    std::vector<Command> commands;
+    std::vector<Quad> quads;
+
+    void clear() {
+        commands.clear();
+        quads.clear();
+    }
+
+    void beginFrame(int screenW, int screenH) {
+        Command c;
+        c.op = Op::BeginFrame;
+        c.screenW = screenW;
+        c.screenH = screenH;
+        commands.push_back(c);
+    }
+
+    void setCamera(glm::vec2 center, float ppu) {
+        Command c;
+        c.op = Op::SetCamera;
+        c.camCenter = center;
+        c.ppu = ppu;
+        commands.push_back(c);
+    }
+
+    /// Quads consecutivos comparten un solo comando.
+    void quad(const Quad& q) {
+        if (commands.empty() || commands.back().op != Op::Quads) {
+            Command c;
+            c.op = Op::Quads;
+            c.first = static_cast<uint32_t>(quads.size());
+            commands.push_back(c);
+        }
+        commands.back().count++;
+        quads.push_back(q);
+    }
+
+    void flush() {
+        Command c;
+        c.op = Op::Flush;
+        commands.push_back(c);
+    }
+
+    void endFrame() {
+        Command c;
+        c.op = Op::EndFrame;
+        commands.push_back(c);
+    }
+};
+
+} // namespace eng
@@ -2,19 +2,47 @@
 #include <vector>
 #include <array>
 #include <cstdint>
+#include <mutex>
+#include "engine/Profiling.h"
 #include "engine/ecs/Components.h"
 #include "engine/render/Texture.h"
+#include "engine/render/RenderSnapshot.h"
+#include "engine/render/RenderBackend.h"
+#include "engine/render/GLRenderBackend.h"
 
 namespace eng {
 
+/// Contadores de un frame de Renderer2D (de beginFrame a endFrame).
+struct RendererStats {
+    uint32_t drawCalls = 0;     // glDrawArrays
+    uint32_t flushes = 0;       // flushBatch, incluidos los que no tenian nada
+    uint32_t slotOverflows = 0; // flushes forzados por quedarse sin texture slots
+    uint32_t textureBinds = 0;  // glBindTexture de las texturas de cada batch
+    uint32_t quads = 0;
+    uint32_t vertices = 0;
+    uint64_t uploadBytes = 0;   // glBufferData de vertices
+};
+
 class Renderer2D {
 public:
-    Renderer2D() = default;
+    /// Dibuja con OpenGL (GLRenderBackend propio).
+    Renderer2D();
+    /// Dibuja con `backend` (p.ej. NullRenderBackend para medir el submit
+    /// sin contexto GL). backend tiene que vivir mas que el renderer.
+    explicit Renderer2D(RenderBackend& backend);
 
+    Renderer2D(const Renderer2D&) = delete;
+    Renderer2D& operator=(const Renderer2D&) = delete;
+
+    /// Crea los recursos del backend (con GL, en el thread del contexto).
     void init();
     void shutdown();
 
     void beginFrame(int screenW, int screenH);
+    /// Cierra el frame: publica sus RendererStats (stats()) y, con
+    /// setProfiler, los manda como contadores "Renderer/...". Grabando, se
+    /// graba y lo hace replay() en el render thread.
+    void endFrame();
     void setCamera(glm::vec2 centerWorld, float pixelsPerUnit);
 
     /// Quad de color solido (compatible con el renderer anterior).
@@ -23,20 +51,45 @@ public:
                     eng::ecs::Color4 color);
 
     /// Quad texturizado con UV rect y color de tinteo.
-    /// glTexId es el OpenGL texture name (obtenido de TextureManager::glId).
+    /// glTexId es el id de textura del backend (con GL, el texture name de
+    /// TextureManager::glId).
     void submitTexturedQuad(glm::vec2 centerWorld, float wWorld, float hWorld,
                             uint32_t glTexId, const Rect& uv,
                             eng::ecs::Color4 tint = {1, 1, 1, 1});
 
     void flush();
 
+    /// Grabacion: entre beginRecording y endRecording, beginFrame/
+    /// setCamera/submit*/flush no tocan GL, se agregan a snapshot (que se
+    /// vacia al empezar). Se puede grabar desde un thread sin contexto GL;
+    /// replay() lo dibuja despues en el thread que tiene el contexto (ver
+    /// RenderPipeline). replay() puede correr mientras otro thread graba.
+    void beginRecording(RenderSnapshot& snapshot);
+    void endRecording();
+    bool recording() const { return m_recording != nullptr; }
+    void replay(const RenderSnapshot& snapshot);
+
+    /// Stats del ultimo frame cerrado con endFrame. Se puede llamar desde
+    /// cualquier thread (en el modo pipelined los publica el render thread).
+    RendererStats stats() const;
+    /// Frames cerrados con endFrame desde el inicio.
+    uint64_t statsFrame() const;
+
+    /// Profiler donde registrar el historial de los stats (nullptr = no).
+    /// Llamar antes de empezar a dibujar.
+    void setProfiler(Profiler* profiler);
+
+    /// Tamano de pantalla para cuando no hay ventana (RenderSystem lo usa
+    /// si ctx.window es nullptr, p.ej. con NullRenderBackend).
+    void setTargetSize(int w, int h) {
+        m_targetW = w;
+        m_targetH = h;
+    }
+    int targetWidth() const { return m_targetW; }
+    int targetHeight() const { return m_targetH; }
+
 private:
-    struct Vertex {
-        float x, y;
-        float r, g, b, a;
-        float u, v;
-        int   texIndex;   // entero puro → viaja sin conversión float
-    };
+    using Vertex = Vertex2D;
 
     // ── Texture slot management ──
     // Hasta 16 texturas distintas pueden estar bindeadas en un batch.
@@ -45,24 +98,35 @@ private:
     std::array<uint32_t, MaxTextureSlots> m_textureSlots{};
     int m_textureSlotCount = 0;
 
-    uint32_t m_whiteTexture = 0; // GL ID de la textura 1x1 blanca del renderer
+    uint32_t m_whiteTexture = 0; // textura 1x1 blanca del backend
 
-    // ── GL state ──
-    uint32_t m_vao = 0;
-    uint32_t m_vbo = 0;
-    uint32_t m_program = 0;
-    int32_t  m_locScreenSize = -1;
+    GLRenderBackend m_glBackend;
+    RenderBackend*  m_backend;
 
     int m_screenW = 1;
     int m_screenH = 1;
+    int m_targetW = 1280;
+    int m_targetH = 720;
 
     glm::vec2 m_camCenter{0.0f, 0.0f};
     float m_ppu = 64.0f;
 
     std::vector<Vertex> m_vertices;
 
-    uint32_t compileShader(uint32_t type, const char* src);
-    uint32_t linkProgram(uint32_t vs, uint32_t fs);
+    RenderSnapshot* m_recording = nullptr;
+
+    // ── Stats ──
+    // m_stats lo acumula el thread que dibuja (el de las *Impl);
+    // endFrameImpl lo copia a m_lastStats bajo el mutex.
+    RendererStats m_stats;
+    RendererStats m_lastStats;
+    uint64_t m_statsFrame = 0;
+    mutable std::mutex m_statsMutex;
+
+    Profiler* m_profiler = nullptr;
+    struct StatCounters {
+        Profiler::ZoneId drawCalls, flushes, slotOverflows, textureBinds, quads, vertices, uploadBytes;
+    } m_counters{};
 
     /// Encuentra o asigna un slot de textura para el GL ID dado.
     /// Si los slots estan llenos, hace un flush intermedio y resetea.
@@ -70,6 +134,14 @@ private:
 
     /// Flush interno (no resetea camera/screen).
     void flushBatch();
+
+    // Implementacion GL de beginFrame/setCamera/submitTexturedQuad (sin
+    // mirar m_recording; replay() las llama directo).
+    void beginFrameImpl(int screenW, int screenH);
+    void endFrameImpl();
+    void setCameraImpl(glm::vec2 centerWorld, float pixelsPerUnit);
+    void submitTexturedQuadImpl(glm::vec2 centerWorld, float wWorld, float hWorld,
+                                uint32_t glTexId, const Rect& uv, eng::ecs::Color4 tint);
 };
 
 } // namespace eng
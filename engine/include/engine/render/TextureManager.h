@@ -23,6 +23,11 @@ public:
     /// Retorna handle 0 (dummy blanca) si la carga falla.
     TextureHandle load(const std::string& path);
 
+    /// Registra una textura ya creada (o ids inventados para un backend sin
+    /// GL, ver NullRenderBackend) y retorna su handle. Sin init(), la
+    /// primera que se agrega queda como handle 0.
+    TextureHandle add(const Texture& texture);
+
     /// Retorna los datos de la textura dado un handle.
     const Texture& get(TextureHandle h) const;
 
@@ -14,7 +14,30 @@
 
 namespace eng {
 
-bool Engine::init() {
+bool Engine::init(const EngineConfig& config) {
+    m_config = config;
+    Profiler::setThreadName("Main");
+
+    if (!m_config.headless && !initWindow()) return false;
+
+    eng::Time::init();
+    eng::Input::init();
+
+    // Setear el contexto en el registry para que los sistemas puedan
+    // acceder a window, renderer, profiler, scheduler, textures, jobs y
+    // animaciones sin globals. Headless: sin window, renderer ni textures.
+    if (m_config.headless) {
+        m_registry.setContext({nullptr, nullptr, &m_profiler, &m_scheduler, nullptr, &m_jobs, &m_animations});
+    } else {
+        m_registry.setContext({m_window, &m_renderer, &m_profiler, &m_scheduler, &m_texManager, &m_jobs,
+                               &m_animations});
+    }
+
+    m_running = true;
+    return true;
+}
+
+bool Engine::initWindow() {
     if(SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_EVENTS) != 0) {
         std::cerr << "SDL_Init failed: " << SDL_GetError() << "\n";
         return false;
@@ -27,11 +50,11 @@ bool Engine::init() {
     SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
 
     m_window = SDL_CreateWindow(
-        "My Engine",
+        m_config.windowTitle,
         SDL_WINDOWPOS_CENTERED,
         SDL_WINDOWPOS_CENTERED,
-        1280,
-        720,
+        m_config.windowWidth,
+        m_config.windowHeight,
         SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE
     );
 
@@ -46,7 +69,7 @@ bool Engine::init() {
         return false;
     }
 
-    SDL_GL_SetSwapInterval(1);
+    SDL_GL_SetSwapInterval(m_config.vsync ? 1 : 0);
     if (!gladLoadGLLoader((GLADloadproc)SDL_GL_GetProcAddress)) {
         std::cerr << "gladLoadGLLoader failed\n";
         return false;
@@ -62,46 +85,83 @@ bool Engine::init() {
     ImGui_ImplSDL2_InitForOpenGL(m_window, m_glContext);
     ImGui_ImplOpenGL3_Init("#version 330");
 
-    eng::Time::init();
-    eng::Input::init();
-
     // Inicializar renderer y texture manager
     m_renderer.init();
+    m_renderer.setProfiler(&m_profiler);
     m_texManager.init();
-
-    // Setear el contexto en el registry para que los sistemas puedan
-    // acceder a window, renderer, profiler, scheduler y textures sin globals.
-    m_registry.setContext({m_window, &m_renderer, &m_profiler, &m_scheduler, &m_texManager});
-
-    m_running = true;
     return true;
 }
 
 void Engine::run() {
-    while (m_running) {
-        eng::Time::beginFrame();
-        m_profiler.beginFrame();
+    if (m_config.pipelinedRender && !m_config.headless) {
+        // Crear los objetos GL del backend de ImGui (shaders, font texture)
+        // mientras el contexto sigue en este thread.
+        ImGui_ImplOpenGL3_NewFrame();
+        m_pipeline = std::make_unique<RenderPipeline>(m_window, m_glContext, m_renderer, m_profiler);
+    }
 
-        SDL_Event e;
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) m_running = false;
-            eng::Input::onEvent(e);
-            ImGui_ImplSDL2_ProcessEvent(&e);
+    uint64_t frames = 0;
+    while (m_running) {
+        if (m_config.headless) {
+            runHeadlessFrame();
+        } else {
+            runFrame();
         }
+        if (m_config.maxFrames != 0 && ++frames >= m_config.maxFrames) m_running = false;
+    }
 
-        // Fixed update loop
-        while (eng::Time::consumeFixedStep()) {
-            m_scheduler.fixedUpdate(m_registry, eng::Time::fixedDeltaTime());
-        }
+    // Devuelve el contexto GL a este thread (shutdown lo necesita).
+    m_pipeline.reset();
+    // Una captura cortada por maxFrames o quit() se escribe igual.
+    m_profiler.finishTrace();
+}
 
-        // ImGui new frame — ANTES de update para que DebugUISystem pueda usar ImGui
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplSDL2_NewFrame();
-        ImGui::NewFrame();
+void Engine::runFrame() {
+    eng::Time::beginFrame();
+    m_profiler.beginFrame();
+
+    SDL_Event e;
+    while (SDL_PollEvent(&e)) {
+        if (e.type == SDL_QUIT) m_running = false;
+        eng::Input::onEvent(e);
+        ImGui_ImplSDL2_ProcessEvent(&e);
+    }
+
+    // Fixed update loop
+    while (eng::Time::consumeFixedStep()) {
+        m_scheduler.fixedUpdate(m_registry, eng::Time::fixedDeltaTime());
+    }
+
+    // ImGui new frame — ANTES de update para que DebugUISystem pueda usar ImGui.
+    // Pipelined: el backend de GL es del render thread (sus objetos ya se
+    // crearon en run()).
+    if (!m_pipeline) ImGui_ImplOpenGL3_NewFrame();
+    ImGui_ImplSDL2_NewFrame();
+    ImGui::NewFrame();
+
+    // Update (incluye InputSystem y DebugUISystem)
+    m_scheduler.update(m_registry, eng::Time::deltaTime());
+
+    float alpha = eng::Time::interpolation();
+    alpha = std::clamp(alpha, 0.0f, 1.0f);
+
+    if (m_pipeline) {
+        // Extraer el frame: los sistemas de Render graban en el snapshot en
+        // vez de dibujar, y el render thread lo dibuja mientras este thread
+        // sigue con el proximo frame.
+        FrameSnapshot& frame = m_pipeline->frame();
+        SDL_GL_GetDrawableSize(m_window, &frame.drawableW, &frame.drawableH);
+
+        m_renderer.beginRecording(frame.render);
+        m_scheduler.render(m_registry, alpha);
+        m_renderer.endFrame();
+        m_renderer.endRecording();
 
-        // Update (incluye InputSystem y DebugUISystem)
-        m_scheduler.update(m_registry, eng::Time::deltaTime());
+        ImGui::Render();
+        frame.captureUi(ImGui::GetDrawData());
 
+        m_pipeline->publish();
+    } else {
         // Actualizar viewport al tamano real de la ventana cada frame.
         // Esto es necesario porque la ventana es resizable (SDL_WINDOW_RESIZABLE).
         {
@@ -114,23 +174,47 @@ void Engine::run() {
         glClear(GL_COLOR_BUFFER_BIT);
 
         // Render
-        float alpha = eng::Time::interpolation();
-        alpha = std::clamp(alpha, 0.0f, 1.0f);
         m_scheduler.render(m_registry, alpha);
+        m_renderer.endFrame();
 
         ImGui::Render();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
         SDL_GL_SwapWindow(m_window);
+    }
+
+    // Cerrar el frame de input DESPUES de todo el procesamiento.
+    // Esto copia s_curr -> s_prev para que el proximo frame
+    // pueda detectar edges (wasPressed / wasReleased).
+    eng::Input::endFrame();
+}
+
+void Engine::runHeadlessFrame() {
+    if (m_config.unthrottled) {
+        eng::Time::beginFrame(eng::Time::fixedDeltaTime());
+    } else {
+        eng::Time::beginFrame();
+    }
+    m_profiler.beginFrame();
 
-        // Cerrar el frame de input DESPUES de todo el procesamiento.
-        // Esto copia s_curr -> s_prev para que el proximo frame
-        // pueda detectar edges (wasPressed / wasReleased).
-        eng::Input::endFrame();
+    bool stepped = false;
+    while (eng::Time::consumeFixedStep()) {
+        m_scheduler.fixedUpdate(m_registry, eng::Time::fixedDeltaTime());
+        stepped = true;
     }
+
+    // Update sin ImGui: DebugUISystem no hace nada sin contexto de ImGui.
+    m_scheduler.update(m_registry, eng::Time::deltaTime());
+
+    eng::Input::endFrame();
+
+    // A velocidad real, no quemar un core esperando el proximo step.
+    if (!m_config.unthrottled && !stepped) SDL_Delay(1);
 }
 
 void Engine::shutdown() {
+    if (m_config.headless) return;
+
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplSDL2_Shutdown();
     m_texManager.shutdown();
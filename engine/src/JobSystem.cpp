@@ -0,0 +1,225 @@
+#include "engine/JobSystem.h"
+#include "engine/Profiling.h"
+#include "engine/ecs/SystemAccess.h"
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+namespace eng {
+
+// Cola propia del thread actual si es worker del JobSystem t_owner; los
+// demas threads usan la cola compartida [0].
+static thread_local const JobSystem* t_owner = nullptr;
+static thread_local unsigned t_queue = 0;
+
+// Intentos de sacar un job antes de que un worker se duerma.
+static constexpr int SpinsBeforeSleep = 64;
+
+JobCounter::~JobCounter() {
+    assert(done() && "JobCounter destroyed with pending jobs!");
+    // El job que lo llevo a 0 puede seguir adentro de finish() con el
+    // mutex tomado: esperar a que lo suelte antes de destruirlo.
+    std::lock_guard<std::mutex> lock(m_mutex);
+}
+
+unsigned JobSystem::defaultWorkerCount() {
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw > 1 ? hw - 1 : 0;
+}
+
+JobSystem::JobSystem(unsigned workerCount) {
+    m_queues.reserve(workerCount + 1);
+    for (unsigned i = 0; i < workerCount + 1; ++i) {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+    m_threads.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        m_threads.emplace_back([this, i] { workerLoop(i + 1); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    m_stop.store(true);
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wakeCv.notify_all();
+    for (auto& t : m_threads) t.join();
+}
+
+unsigned JobSystem::currentQueue() const {
+    return t_owner == this ? t_queue : 0;
+}
+
+void JobSystem::run(JobFn fn, JobCounter* counter) {
+    if (counter) counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    push(Job{std::move(fn), counter});
+}
+
+void JobSystem::runAfter(JobCounter& dependency, JobFn fn, JobCounter* counter) {
+    if (counter) counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    Job job{std::move(fn), counter};
+    {
+        std::lock_guard<std::mutex> lock(dependency.m_mutex);
+        if (!dependency.done()) {
+            dependency.m_continuations.push_back(std::move(job));
+            return;
+        }
+    }
+    push(std::move(job));
+}
+
+void JobSystem::push(Job job) {
+    // Sin workers no hay quien lo saque de la cola: se ejecuta ya.
+    if (m_threads.empty()) {
+        execute(job);
+        return;
+    }
+
+    // m_queued sube ANTES de encolar: un worker que lo ve en 0 no se
+    // pierde el job (a lo sumo reintenta una vez con la cola vacia).
+    m_queued.fetch_add(1);
+    Queue& q = *m_queues[currentQueue()];
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.jobs.push_back(std::move(job));
+    }
+
+    // Pareado con workerLoop: el worker sube m_sleepers y despues mira
+    // m_queued, aca es al reves; alguno de los dos ve al otro.
+    if (m_sleepers.load() > 0) {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wakeCv.notify_one();
+    }
+}
+
+bool JobSystem::tryPop(unsigned queueIndex, Job& out) {
+    if (m_queued.load(std::memory_order_relaxed) == 0) return false;
+
+    // Cola propia: del final (LIFO).
+    {
+        Queue& q = *m_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.jobs.empty()) {
+            out = std::move(q.jobs.back());
+            q.jobs.pop_back();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Robar del principio (FIFO) de las otras, empezando por la siguiente
+    // para no ir todos contra la misma.
+    const unsigned n = static_cast<unsigned>(m_queues.size());
+    for (unsigned i = 1; i < n; ++i) {
+        Queue& q = *m_queues[(queueIndex + i) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.jobs.empty()) {
+            out = std::move(q.jobs.front());
+            q.jobs.pop_front();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::execute(Job& job) {
+    job.fn();
+    job.fn = nullptr; // soltar lo capturado antes de avisar que termino
+    if (job.counter) finish(*job.counter);
+}
+
+void JobSystem::finish(JobCounter& counter) {
+    std::vector<Job> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter.m_mutex);
+        if (counter.m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            ready.swap(counter.m_continuations);
+        }
+    }
+    // counter ya no se toca: el que espera puede destruirlo.
+    for (Job& job : ready) push(std::move(job));
+}
+
+void JobSystem::wait(const JobCounter& counter) {
+    const unsigned self = currentQueue();
+    while (!counter.done()) {
+        Job job;
+        if (tryPop(self, job)) {
+            // El job no es de quien espera: no hereda el AccessGuard del
+            // sistema que llamo (los chunks de parallelEach instalan el suyo).
+            ecs::detail::AccessGuardScope noGuard(nullptr);
+            execute(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const RangeFn& fn) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+    const size_t chunks = (count + grain - 1) / grain;
+
+    if (m_threads.empty() || chunks == 1) {
+        fn(0, count);
+        return;
+    }
+
+    // Un job por worker (no uno por chunk): cada uno toma chunks de un
+    // indice compartido hasta que se acaban, asi el reparto se balancea
+    // solo aunque los chunks tarden distinto.
+    std::atomic<size_t> nextChunk{0};
+    auto runChunks = [&] {
+        for (;;) {
+            const size_t c = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (c >= chunks) return;
+            const size_t begin = c * grain;
+            fn(begin, std::min(begin + grain, count));
+        }
+    };
+
+    JobCounter counter;
+    const size_t helpers = std::min<size_t>(m_threads.size(), chunks - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        run([&runChunks] { runChunks(); }, &counter);
+    }
+
+    // El caller tambien procesa chunks y despues ayuda hasta que terminan
+    // los helpers (un helper que arranca tarde no encuentra chunks y sale).
+    runChunks();
+    wait(counter);
+}
+
+void JobSystem::workerLoop(unsigned queueIndex) {
+    t_owner = this;
+    t_queue = queueIndex;
+    Profiler::setThreadName("Worker " + std::to_string(queueIndex));
+
+    int idle = 0;
+    for (;;) {
+        Job job;
+        if (tryPop(queueIndex, job)) {
+            execute(job);
+            idle = 0;
+            continue;
+        }
+        if (++idle < SpinsBeforeSleep) {
+            std::this_thread::yield();
+            continue;
+        }
+        idle = 0;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepers.fetch_add(1);
+        m_wakeCv.wait(lock, [this] { return m_stop.load() || m_queued.load() > 0; });
+        m_sleepers.fetch_sub(1);
+        if (m_stop.load() && m_queued.load() == 0) return;
+    }
+}
+
+} // namespace eng
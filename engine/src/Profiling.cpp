@@ -0,0 +1,332 @@
+#include "engine/Profiling.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+
+namespace eng {
+
+static_assert((Profiler::QueueCapacity & (Profiler::QueueCapacity - 1)) == 0,
+              "Profiler::QueueCapacity must be a power of two.");
+
+// ────────────────────────────────────────────────────────────────
+// Threads (para las capturas)
+// ────────────────────────────────────────────────────────────────
+
+// Indice chico y estable por thread (el tid de las capturas).
+static std::atomic<uint32_t> s_nextThread{0};
+static thread_local uint32_t t_thread = s_nextThread.fetch_add(1, std::memory_order_relaxed);
+
+static std::mutex s_threadNamesMutex;
+static std::vector<std::pair<uint32_t, std::string>> s_threadNames;
+
+void Profiler::setThreadName(std::string_view name) {
+    std::lock_guard<std::mutex> lock(s_threadNamesMutex);
+    for (auto& entry : s_threadNames) {
+        if (entry.first == t_thread) {
+            entry.second = std::string(name);
+            return;
+        }
+    }
+    s_threadNames.emplace_back(t_thread, std::string(name));
+}
+
+// ────────────────────────────────────────────────────────────────
+// MonotonicQueue
+// ────────────────────────────────────────────────────────────────
+
+void Profiler::MonotonicQueue::reset(size_t cap) {
+    entries = std::make_unique<Entry[]>(cap);
+    capacity = cap;
+    head = size = 0;
+}
+
+template <typename KeepBack>
+void Profiler::MonotonicQueue::push(uint64_t index, double value, uint64_t window, KeepBack keepBack) {
+    // Sacar del frente los que salen de la ventana con este sample (antes
+    // de agregarlo: asi nunca hay mas de window entradas).
+    while (size > 0 && entries[head].index + window <= index) {
+        head = (head + 1) % capacity;
+        --size;
+    }
+
+    // Sacar del final los que ya no pueden ser el min/max mientras este
+    // sample siga en la ventana.
+    while (size > 0 && !keepBack(entries[(head + size - 1) % capacity].value, value)) --size;
+    entries[(head + size) % capacity] = Entry{index, value};
+    ++size;
+}
+
+// ────────────────────────────────────────────────────────────────
+// Profiler
+// ────────────────────────────────────────────────────────────────
+
+static std::atomic<uint32_t> s_nextSerial{1};
+
+Profiler::Profiler(size_t window, size_t maxWindow)
+    : m_serial(s_nextSerial.fetch_add(1, std::memory_order_relaxed)),
+      m_window(std::clamp<size_t>(window, 1, std::max<size_t>(maxWindow, 1))),
+      m_maxWindow(std::max<size_t>(maxWindow, 1)),
+      m_queue(std::make_unique<Slot[]>(QueueCapacity)) {
+    for (size_t i = 0; i < QueueCapacity; ++i) {
+        m_queue[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+Profiler::~Profiler() = default;
+
+Profiler::ZoneId Profiler::registerZone(std::string_view name) {
+    return registerZone(name, false);
+}
+
+Profiler::ZoneId Profiler::registerCounter(std::string_view name) {
+    return registerZone(name, true);
+}
+
+Profiler::ZoneId Profiler::registerZone(std::string_view name, bool counter) {
+    std::lock_guard<std::mutex> lock(m_registerMutex);
+    const size_t count = m_zoneCount.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (m_zones[i]->name == name) return static_cast<ZoneId>(i);
+    }
+    assert(count < MaxZones && "Profiler: too many zones!");
+    if (count >= MaxZones) return InvalidZone;
+
+    auto zone = std::make_unique<Zone>();
+    zone->name = std::string(name);
+    zone->counter = counter;
+    zone->ring = std::make_unique<double[]>(m_maxWindow);
+    zone->minQueue.reset(m_maxWindow);
+    zone->maxQueue.reset(m_maxWindow);
+    m_zones[count] = std::move(zone);
+    m_zoneCount.store(count + 1, std::memory_order_release);
+    return static_cast<ZoneId>(count);
+}
+
+void Profiler::submit(ZoneId zone, double ms) {
+    push(zone, t_openZone, 0, ms);
+}
+
+void Profiler::submitCounter(ZoneId counter, double value) {
+    push(counter, InvalidZone, SDL_GetPerformanceCounter(), value);
+}
+
+void Profiler::push(ZoneId zone, ZoneId parent, uint64_t start, double ms) {
+    if (zone == InvalidZone) return;
+    assert(zone < zoneCount() && "Profiler: zone id from another profiler!");
+
+    uint64_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = m_queue[pos & (QueueCapacity - 1)];
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const int64_t diff = static_cast<int64_t>(sequence - pos);
+        if (diff == 0) {
+            // Libre para esta posicion: reservarla.
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.zone = zone;
+                slot.parent = parent;
+                slot.thread = t_thread;
+                slot.start = start;
+                slot.ms = ms;
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return;
+            }
+        } else if (diff < 0) {
+            // Todavia tiene un sample de la vuelta anterior sin leer: llena.
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Profiler::collect() {
+    for (;;) {
+        Slot& slot = m_queue[m_dequeuePos & (QueueCapacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1) break;
+
+        apply(*m_zones[slot.zone], slot.parent, slot.ms);
+        if (m_traceFramesLeft > 0 && slot.start != 0 && slot.start >= m_traceStart) {
+            m_traceEvents.push_back(TraceEvent{slot.zone, slot.thread, slot.start, slot.ms});
+        }
+        // Libre para la proxima vuelta del productor.
+        slot.sequence.store(m_dequeuePos + QueueCapacity, std::memory_order_release);
+        ++m_dequeuePos;
+    }
+}
+
+void Profiler::beginFrame() {
+    collect();
+
+    const uint64_t now = SDL_GetPerformanceCounter();
+    if (m_traceFramesLeft > 0) {
+        if (--m_traceFramesLeft == 0) {
+            writeTrace(now);
+        } else {
+            m_traceFrames.push_back(now);
+        }
+    } else if (m_traceRequest > 0) {
+        m_traceFramesLeft = m_traceRequest;
+        m_tracePath = std::move(m_traceRequestPath);
+        m_traceRequest = 0;
+        m_traceStart = now;
+        m_traceEvents.clear();
+        m_traceFrames.clear();
+        m_traceFrames.push_back(now);
+    }
+}
+
+void Profiler::apply(Zone& zone, ZoneId parent, double ms) {
+    const uint64_t index = zone.count++;
+    // Una zona que a veces corre suelta (p.ej. en un worker) queda colgada
+    // de la primera zona que la tuvo abierta.
+    if (zone.parent == InvalidZone) zone.parent = parent;
+    const uint64_t window = m_window;
+
+    // Suma corrida: entra el nuevo, sale el que cae fuera de la ventana.
+    if (index >= window) zone.sum -= zone.ring[(index - window) % m_maxWindow];
+    zone.ring[index % m_maxWindow] = ms;
+    zone.sum += ms;
+    // Cada vuelta del ring se recalcula exacta (O(window) cada window
+    // samples: sigue siendo O(1) amortizado y no acumula error de redondeo).
+    if (index % m_maxWindow == m_maxWindow - 1) {
+        const uint64_t n = std::min<uint64_t>(zone.count, window);
+        double exact = 0.0;
+        for (uint64_t i = zone.count - n; i < zone.count; ++i) exact += zone.ring[i % m_maxWindow];
+        zone.sum = exact;
+    }
+
+    zone.minQueue.push(index, ms, window, [](double back, double v) { return back < v; });
+    zone.maxQueue.push(index, ms, window, [](double back, double v) { return back > v; });
+
+    const uint64_t n = std::min<uint64_t>(zone.count, window);
+    zone.stats.lastMs = ms;
+    zone.stats.samples = static_cast<size_t>(n);
+    zone.stats.avgMs = zone.sum / static_cast<double>(n);
+    zone.stats.minMs = zone.minQueue.front();
+    zone.stats.maxMs = zone.maxQueue.front();
+}
+
+void Profiler::rebuild(Zone& zone) {
+    // Stats de los ultimos min(count, window) samples que siguen en el ring.
+    const uint64_t n = std::min<uint64_t>(zone.count, m_window);
+    zone.sum = 0.0;
+    zone.minQueue.clear();
+    zone.maxQueue.clear();
+    for (uint64_t i = zone.count - n; i < zone.count; ++i) {
+        const double ms = zone.ring[i % m_maxWindow];
+        zone.sum += ms;
+        zone.minQueue.push(i, ms, m_window, [](double back, double v) { return back < v; });
+        zone.maxQueue.push(i, ms, m_window, [](double back, double v) { return back > v; });
+    }
+
+    zone.stats.samples = static_cast<size_t>(n);
+    if (n == 0) return;
+    zone.stats.avgMs = zone.sum / static_cast<double>(n);
+    zone.stats.minMs = zone.minQueue.front();
+    zone.stats.maxMs = zone.maxQueue.front();
+}
+
+void Profiler::setWindow(size_t window) {
+    window = std::clamp<size_t>(window, 1, m_maxWindow);
+    if (window == m_window) return;
+    m_window = window;
+    const size_t count = m_zoneCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) rebuild(*m_zones[i]);
+}
+
+// ────────────────────────────────────────────────────────────────
+// Capturas (Chrome Trace Event JSON)
+// ────────────────────────────────────────────────────────────────
+
+void Profiler::captureTrace(size_t frames, std::string path) {
+    m_traceRequest = std::max<size_t>(frames, 1);
+    m_traceRequestPath = std::move(path);
+    m_traceFramesLeft = 0;
+}
+
+void Profiler::finishTrace() {
+    if (m_traceFramesLeft == 0) return;
+    collect();
+    m_traceFramesLeft = 0;
+    writeTrace(SDL_GetPerformanceCounter());
+}
+
+static void writeJsonString(std::FILE* f, std::string_view str) {
+    std::fputc('"', f);
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            std::fputc('\\', f);
+            std::fputc(c, f);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            std::fprintf(f, "\\u%04x", static_cast<unsigned>(c));
+        } else {
+            std::fputc(c, f);
+        }
+    }
+    std::fputc('"', f);
+}
+
+void Profiler::writeTrace(uint64_t end) {
+    m_lastTrace.clear();
+    std::FILE* f = std::fopen(m_tracePath.c_str(), "wb");
+    if (!f) {
+        SDL_Log("Profiler: could not write trace '%s'", m_tracePath.c_str());
+        m_traceEvents.clear();
+        return;
+    }
+
+    // Timestamps en microsegundos desde el inicio de la captura.
+    const double usPerTick = 1e6 / static_cast<double>(SDL_GetPerformanceFrequency());
+    auto toUs = [&](uint64_t ticks) {
+        return static_cast<double>(ticks - m_traceStart) * usPerTick;
+    };
+
+    std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    // tid 0 = track de frames; cada thread va con su indice + 1.
+    std::fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"engine\"}}");
+    std::fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Frames\"}}");
+    {
+        std::lock_guard<std::mutex> lock(s_threadNamesMutex);
+        for (const auto& [thread, name] : s_threadNames) {
+            std::fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                         thread + 1);
+            writeJsonString(f, name);
+            std::fprintf(f, "}}");
+        }
+    }
+
+    // Un slice por frame en el track de frames.
+    for (size_t i = 0; i < m_traceFrames.size(); ++i) {
+        const uint64_t frameEnd = i + 1 < m_traceFrames.size() ? m_traceFrames[i + 1] : end;
+        std::fprintf(f, ",\n{\"name\":\"Frame %zu\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":0,"
+                        "\"ts\":%.3f,\"dur\":%.3f}",
+                     i, toUs(m_traceFrames[i]), toUs(frameEnd) - toUs(m_traceFrames[i]));
+    }
+
+    for (const TraceEvent& ev : m_traceEvents) {
+        std::fprintf(f, ",\n{\"name\":");
+        writeJsonString(f, m_zones[ev.zone]->name);
+        if (m_zones[ev.zone]->counter) {
+            std::fprintf(f, ",\"cat\":\"counter\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"value\":%.17g}}",
+                         toUs(ev.start), ev.ms);
+            continue;
+        }
+        std::fprintf(f, ",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                     ev.thread + 1, toUs(ev.start), ev.ms * 1000.0);
+    }
+    std::fprintf(f, "\n]}\n");
+
+    const bool ok = std::fclose(f) == 0;
+    if (ok) {
+        m_lastTrace = m_tracePath;
+        SDL_Log("Profiler: wrote %zu events to '%s'", m_traceEvents.size(), m_tracePath.c_str());
+    } else {
+        SDL_Log("Profiler: could not write trace '%s'", m_tracePath.c_str());
+    }
+    m_traceEvents.clear();
+    m_traceFrames.clear();
+}
+
+} // namespace eng
@@ -27,6 +27,14 @@ namespace eng {
         s_frame++;
     }
 
+    void Time::beginFrame(float dt) {
+        s_deltaTime = dt;
+        if (!s_paused) {
+            s_accumulator += s_deltaTime;
+        }
+        s_frame++;
+    }
+
     float Time::deltaTime() {
         return s_deltaTime;
     }
@@ -0,0 +1,276 @@
+#include "engine/ecs/ArchetypeRegistry.h"
+
+#include <algorithm>
+
+namespace eng::ecs {
+
+// ────────────────────────────────────────────────────────────────
+// Archetype
+// ────────────────────────────────────────────────────────────────
+
+static size_t alignUp(size_t v, size_t a) {
+    return (v + a - 1) & ~(a - 1);
+}
+
+Archetype::Archetype(std::vector<const ComponentInfo*> infos)
+    : m_infos(std::move(infos)) {
+    size_t rowBytes = sizeof(Entity);
+    ComponentTypeId maxId = 0;
+    for (const ComponentInfo* info : m_infos) {
+        assert(info->align <= ArchetypeChunk::MaxAlign && "Component alignment too big for a chunk!");
+        m_types.push_back(info->id);
+        rowBytes += info->size;
+        maxId = std::max(maxId, info->id);
+    }
+
+    m_columnByType.assign(m_infos.empty() ? 0 : maxId + 1, -1);
+    for (size_t c = 0; c < m_types.size(); ++c) {
+        m_columnByType[m_types[c]] = static_cast<int32_t>(c);
+    }
+
+    // Capacidad: cuantas filas entran en el chunk respetando el alignment
+    // de cada columna. Arrancamos por la cota sin padding y bajamos hasta
+    // que el layout entra.
+    m_offsets.assign(m_infos.size(), 0);
+    uint32_t cap = static_cast<uint32_t>(ArchetypeChunk::Bytes / rowBytes);
+    for (; cap > 0; --cap) {
+        size_t offset = cap * sizeof(Entity);
+        for (size_t c = 0; c < m_infos.size(); ++c) {
+            if (m_infos[c]->size == 0) continue; // tag: sin columna real
+            offset = alignUp(offset, m_infos[c]->align);
+            m_offsets[c] = offset;
+            offset += cap * m_infos[c]->size;
+        }
+        if (offset <= ArchetypeChunk::Bytes) break;
+    }
+    assert(cap > 0 && "Archetype row does not fit in a single chunk!");
+    m_capacity = cap;
+}
+
+// ────────────────────────────────────────────────────────────────
+// ArchetypeRegistry
+// ────────────────────────────────────────────────────────────────
+
+ArchetypeRegistry::ArchetypeRegistry() {
+    m_root = archetypeFor({});
+}
+
+ArchetypeRegistry::~ArchetypeRegistry() {
+    clear();
+}
+
+Entity ArchetypeRegistry::create() {
+    uint32_t index;
+
+    if (!m_freeList.empty()) {
+        index = m_freeList.back();
+        m_freeList.pop_back();
+    } else {
+        index = static_cast<uint32_t>(m_slots.size());
+        m_slots.push_back(Slot{});
+    }
+
+    Slot& slot = m_slots[index];
+    slot.alive = true;
+
+    Entity e{ index, slot.generation };
+    slot.loc = allocRow(*m_root, e);
+
+    m_aliveCount++;
+    return e;
+}
+
+bool ArchetypeRegistry::isAlive(Entity e) const {
+    if (!e.isValid()) return false;
+    if (e.index >= m_slots.size()) return false;
+
+    const Slot& slot = m_slots[e.index];
+    return slot.alive && slot.generation == e.generation;
+}
+
+void ArchetypeRegistry::destroy(Entity e) {
+    if (!isAlive(e)) return;
+
+    Slot& slot = m_slots[e.index];
+    const Location loc = slot.loc;
+    Archetype& a = *loc.archetype;
+    for (size_t c = 0; c < a.m_infos.size(); ++c) {
+        if (a.m_infos[c]->size) a.m_infos[c]->destroy(cell(loc, c));
+    }
+    removeRow(loc);
+
+    slot.alive = false;
+    slot.generation++;          // invalida handles viejos
+    slot.loc = {};
+    m_freeList.push_back(e.index);
+
+    m_aliveCount--;
+}
+
+void ArchetypeRegistry::clear() {
+    for (auto& a : m_archetypes) {
+        for (auto& chunk : a->m_chunks) {
+            for (size_t c = 0; c < a->m_infos.size(); ++c) {
+                const ComponentInfo& info = *a->m_infos[c];
+                if (!info.size) continue;
+                std::byte* column = static_cast<std::byte*>(a->columnData(*chunk, static_cast<int>(c)));
+                for (uint32_t row = 0; row < chunk->count; ++row) {
+                    info.destroy(column + row * info.size);
+                }
+            }
+        }
+        a->m_chunks.clear();
+        a->m_count = 0;
+    }
+    m_freeChunks.clear();
+    m_slots.clear();
+    m_freeList.clear();
+    m_aliveCount = 0;
+}
+
+size_t ArchetypeRegistry::chunkCount() const {
+    size_t n = 0;
+    for (const auto& a : m_archetypes) n += a->chunkCount();
+    return n;
+}
+
+void* ArchetypeRegistry::cell(const Location& loc, size_t col) {
+    Archetype& a = *loc.archetype;
+    std::byte* column = static_cast<std::byte*>(a.columnData(a.chunk(loc.chunk), static_cast<int>(col)));
+    return column + loc.row * a.m_infos[col]->size;
+}
+
+// ── Grafo de archetypes ──
+
+Archetype* ArchetypeRegistry::archetypeFor(std::vector<const ComponentInfo*> infos) {
+    std::vector<ComponentTypeId> key;
+    key.reserve(infos.size());
+    for (const ComponentInfo* info : infos) key.push_back(info->id);
+
+    auto it = m_archetypeIndex.find(key);
+    if (it != m_archetypeIndex.end()) return it->second;
+
+    m_archetypes.push_back(std::make_unique<Archetype>(std::move(infos)));
+    Archetype* a = m_archetypes.back().get();
+    m_archetypeIndex.emplace(std::move(key), a);
+    return a;
+}
+
+Archetype* ArchetypeRegistry::addEdge(Archetype* from, const ComponentInfo& info) {
+    if (info.id < from->m_addEdge.size() && from->m_addEdge[info.id]) {
+        return from->m_addEdge[info.id];
+    }
+
+    std::vector<const ComponentInfo*> infos = from->m_infos;
+    auto pos = std::lower_bound(infos.begin(), infos.end(), info.id,
+        [](const ComponentInfo* a, ComponentTypeId id) { return a->id < id; });
+    infos.insert(pos, &info);
+    Archetype* to = archetypeFor(std::move(infos));
+
+    // Cachear la arista en ambos sentidos.
+    if (info.id >= from->m_addEdge.size()) from->m_addEdge.resize(info.id + 1, nullptr);
+    from->m_addEdge[info.id] = to;
+    if (info.id >= to->m_removeEdge.size()) to->m_removeEdge.resize(info.id + 1, nullptr);
+    to->m_removeEdge[info.id] = from;
+    return to;
+}
+
+Archetype* ArchetypeRegistry::removeEdge(Archetype* from, ComponentTypeId id) {
+    if (id < from->m_removeEdge.size() && from->m_removeEdge[id]) {
+        return from->m_removeEdge[id];
+    }
+
+    std::vector<const ComponentInfo*> infos = from->m_infos;
+    const ComponentInfo* removed = nullptr;
+    for (auto it = infos.begin(); it != infos.end(); ++it) {
+        if ((*it)->id == id) { removed = *it; infos.erase(it); break; }
+    }
+    assert(removed);
+    Archetype* to = archetypeFor(std::move(infos));
+
+    if (id >= from->m_removeEdge.size()) from->m_removeEdge.resize(id + 1, nullptr);
+    from->m_removeEdge[id] = to;
+    if (id >= to->m_addEdge.size()) to->m_addEdge.resize(id + 1, nullptr);
+    to->m_addEdge[id] = from;
+    return to;
+}
+
+// ── Filas ──
+
+ArchetypeRegistry::Location ArchetypeRegistry::allocRow(Archetype& a, Entity e) {
+    if (a.m_chunks.empty() || a.m_chunks.back()->count == a.m_capacity) {
+        if (!m_freeChunks.empty()) {
+            a.m_chunks.push_back(std::move(m_freeChunks.back()));
+            m_freeChunks.pop_back();
+        } else {
+            // new sin () para no poner en cero los 16 KB: count ya arranca en 0.
+            a.m_chunks.push_back(std::unique_ptr<ArchetypeChunk>(new ArchetypeChunk));
+        }
+    }
+    ArchetypeChunk& chunk = *a.m_chunks.back();
+
+    Location loc;
+    loc.archetype = &a;
+    loc.chunk = static_cast<uint32_t>(a.m_chunks.size() - 1);
+    loc.row = chunk.count++;
+    a.entities(chunk)[loc.row] = e;
+    a.m_count++;
+    return loc;
+}
+
+void ArchetypeRegistry::removeRow(const Location& hole) {
+    // Los componentes de `hole` ya fueron destruidos (o movidos) por el
+    // caller. Rellenamos el hueco con la ultima fila del archetype para que
+    // todos los chunks sigan llenos salvo el ultimo.
+    Archetype& a = *hole.archetype;
+    ArchetypeChunk& lastChunk = *a.m_chunks.back();
+    Location last{ &a, static_cast<uint32_t>(a.m_chunks.size() - 1), lastChunk.count - 1 };
+
+    if (last.chunk != hole.chunk || last.row != hole.row) {
+        for (size_t c = 0; c < a.m_infos.size(); ++c) {
+            const ComponentInfo& info = *a.m_infos[c];
+            if (!info.size) continue;
+            void* src = cell(last, c);
+            info.moveConstruct(cell(hole, c), src);
+            info.destroy(src);
+        }
+        Entity moved = a.entities(lastChunk)[last.row];
+        a.entities(a.chunk(hole.chunk))[hole.row] = moved;
+        m_slots[moved.index].loc = hole;
+    }
+
+    lastChunk.count--;
+    a.m_count--;
+    if (lastChunk.count == 0) {
+        // Reciclar el chunk: al construir entidades componente a componente
+        // cada archetype intermedio se vacia y se vuelve a llenar todo el tiempo.
+        m_freeChunks.push_back(std::move(a.m_chunks.back()));
+        a.m_chunks.pop_back();
+    }
+}
+
+void ArchetypeRegistry::moveToArchetype(Entity e, Archetype* dst) {
+    Slot& slot = m_slots[e.index];
+    const Location src = slot.loc;
+    Archetype& from = *src.archetype;
+
+    const Location to = allocRow(*dst, e);
+
+    // Columnas compartidas se mueven; las que dst no tiene se destruyen.
+    // Las que solo tiene dst quedan sin construir (las construye emplace).
+    for (size_t c = 0; c < from.m_infos.size(); ++c) {
+        const ComponentInfo& info = *from.m_infos[c];
+        if (!info.size) continue;
+        void* value = cell(src, c);
+        int dc = dst->column(info.id);
+        if (dc >= 0) {
+            info.moveConstruct(cell(to, static_cast<size_t>(dc)), value);
+        }
+        info.destroy(value);
+    }
+
+    removeRow(src);
+    slot.loc = to;
+}
+
+} // namespace eng::ecs
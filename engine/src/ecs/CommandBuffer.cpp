@@ -0,0 +1,121 @@
+#include "engine/ecs/CommandBuffer.h"
+
+#include <atomic>
+
+namespace eng::ecs {
+
+// ────────────────────────────────────────────────────────────────
+// CommandBuffer
+// ────────────────────────────────────────────────────────────────
+
+void CommandBuffer::playback(Registry& reg) {
+    resolveCreates(reg);
+    applyEmplaces(reg);
+    applyRemoves(reg);
+
+    std::vector<Entity> destroys;
+    appendDestroys(destroys);
+    destroySorted(reg, destroys);
+
+    reset();
+}
+
+void CommandBuffer::resolveCreates(Registry& reg) {
+    m_created.resize(m_tempCount);
+    if (m_tempCount > 0) reg.create(m_created);
+}
+
+void CommandBuffer::applyEmplaces(Registry& reg) {
+    std::sort(m_emplaceTypes.begin(), m_emplaceTypes.end());
+    for (ComponentTypeId id : m_emplaceTypes) {
+        m_emplaces[id]->apply(reg, *this);
+    }
+}
+
+void CommandBuffer::applyRemoves(Registry& reg) {
+    std::stable_sort(m_removes.begin(), m_removes.end(), [](const RemoveOp& a, const RemoveOp& b) {
+        if (a.id != b.id) return a.id < b.id;
+        return a.e.index < b.e.index;
+    });
+    for (const RemoveOp& op : m_removes) {
+        op.apply(reg, resolve(op.e));
+    }
+}
+
+void CommandBuffer::appendDestroys(std::vector<Entity>& out) const {
+    for (Entity e : m_destroys) out.push_back(resolve(e));
+}
+
+void CommandBuffer::reset() {
+    for (ComponentTypeId id : m_emplaceTypes) m_emplaces[id]->clear();
+    m_emplaceTypes.clear();
+    m_removes.clear();
+    m_destroys.clear();
+    m_created.clear();
+    m_tempCount = 0;
+}
+
+void CommandBuffer::destroySorted(Registry& reg, std::vector<Entity>& entities) {
+    std::sort(entities.begin(), entities.end(), [](Entity a, Entity b) {
+        return a.index != b.index ? a.index < b.index : a.generation < b.generation;
+    });
+    entities.erase(std::unique(entities.begin(), entities.end()), entities.end());
+    reg.destroy(std::span<const Entity>(entities));
+}
+
+// ────────────────────────────────────────────────────────────────
+// CommandQueue
+// ────────────────────────────────────────────────────────────────
+
+namespace {
+
+std::atomic<uint64_t> s_nextQueueId{1};
+
+// Cache por thread: (queue, buffer). Las colas son pocas (una por
+// scheduler) asi que un vector chico alcanza.
+struct LocalBufferEntry {
+    uint64_t       queueId;
+    CommandBuffer* buffer;
+};
+thread_local std::vector<LocalBufferEntry> t_localBuffers;
+
+} // namespace
+
+CommandQueue::CommandQueue()
+    : m_queueId(s_nextQueueId.fetch_add(1, std::memory_order_relaxed)) {}
+
+CommandBuffer& CommandQueue::local() {
+    for (const LocalBufferEntry& entry : t_localBuffers) {
+        if (entry.queueId == m_queueId) return *entry.buffer;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_buffers.push_back(std::make_unique<CommandBuffer>(static_cast<uint32_t>(m_buffers.size())));
+    CommandBuffer* buffer = m_buffers.back().get();
+    t_localBuffers.push_back({m_queueId, buffer});
+    return *buffer;
+}
+
+bool CommandQueue::empty() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& b : m_buffers) {
+        if (!b->empty()) return false;
+    }
+    return true;
+}
+
+void CommandQueue::playback(Registry& reg) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto& b : m_buffers) b->resolveCreates(reg);
+    for (auto& b : m_buffers) b->applyEmplaces(reg);
+    for (auto& b : m_buffers) b->applyRemoves(reg);
+
+    std::vector<Entity> destroys;
+    for (auto& b : m_buffers) b->appendDestroys(destroys);
+    CommandBuffer::destroySorted(reg, destroys);
+
+    for (auto& b : m_buffers) b->reset();
+}
+
+} // namespace eng::ecs
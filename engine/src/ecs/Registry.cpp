@@ -1,8 +1,42 @@
 #include "engine/ecs/Registry.h"
 
+#include <algorithm>
+
 namespace eng::ecs {
 
+// lastRunTick y slice del sistema que corre en este thread
+// (SystemRunScope). Guarda el registry para no mezclar dos registries en
+// el mismo thread.
+static thread_local const Registry* t_runRegistry = nullptr;
+static thread_local uint32_t t_runTick = 0;
+static thread_local TimeSlice t_runSlice;
+
+uint32_t Registry::lastRunTick() const {
+    return t_runRegistry == this ? t_runTick : m_lastRunTick;
+}
+
+TimeSlice Registry::timeSlice() const {
+    return t_runRegistry == this ? t_runSlice : m_timeSlice;
+}
+
+Registry::SystemRunScope::SystemRunScope(const Registry& reg, uint32_t runTick, uint32_t lastRunTick,
+                                         TimeSlice slice)
+    : m_prevReg(t_runRegistry), m_prevTick(t_runTick), m_prevSlice(t_runSlice),
+      m_writeTick({&reg.m_tick, runTick}) {
+    t_runRegistry = &reg;
+    t_runTick = lastRunTick;
+    t_runSlice = slice;
+}
+
+Registry::SystemRunScope::~SystemRunScope() {
+    t_runRegistry = m_prevReg;
+    t_runTick = m_prevTick;
+    t_runSlice = m_prevSlice;
+}
+
 Entity Registry::create() {
+    assert(!structureLocked() && "Structural change during parallelEach!");
+    checkStructural("create");
     uint32_t index;
 
     if (!m_freeList.empty()) {
@@ -29,13 +63,24 @@ bool Registry::isAlive(Entity e) const {
 }
 
 void Registry::removeAllComponents(Entity e) {
-    for (auto& kv : m_pools) {
-        kv.second->removeIfExists(e);
+    // Primero sacar a e de los grupos (lo mueve fuera de la zona empaquetada)
+    // y recien despues hacer el swap-remove en cada pool. Solo se tocan los
+    // pools que marca la mascara del slot, no todos los del registry.
+    ComponentMask& mask = m_slots[e.index].mask;
+    for (auto& g : m_groups) {
+        if (mask.test(g->owned.front())) groupRemove(*g, e);
     }
+    mask.forEach([&](ComponentTypeId id) {
+        m_pools[id]->removeIfExists(e);
+    });
+    mask.clear();
+    m_motion.remove(e);
 }
 
 void Registry::destroy(Entity e) {
     if (!isAlive(e)) return;
+    assert(!structureLocked() && "Structural change during parallelEach!");
+    checkStructural("destroy");
 
     removeAllComponents(e);
 
@@ -47,14 +92,139 @@ void Registry::destroy(Entity e) {
     m_aliveCount--;
 }
 
+void Registry::create(std::span<Entity> out) {
+    assert(!structureLocked() && "Structural change during parallelEach!");
+    checkStructural("create");
+    size_t i = 0;
+
+    // Primero los indices libres (mas recientes primero, igual que create()).
+    for (; i < out.size() && !m_freeList.empty(); ++i) {
+        const uint32_t index = m_freeList.back();
+        m_freeList.pop_back();
+        Slot& slot = m_slots[index];
+        slot.alive = true;
+        out[i] = Entity{ index, slot.generation };
+    }
+
+    // El resto son slots nuevos: una sola realocacion.
+    const size_t fresh = out.size() - i;
+    if (fresh > 0) {
+        const size_t first = m_slots.size();
+        m_slots.resize(first + fresh);
+        for (size_t k = 0; k < fresh; ++k, ++i) {
+            Slot& slot = m_slots[first + k];
+            slot.alive = true;
+            out[i] = Entity{ static_cast<uint32_t>(first + k), slot.generation };
+        }
+    }
+
+    m_aliveCount += out.size();
+}
+
+void Registry::destroy(std::span<const Entity> entities) {
+    m_freeList.reserve(m_freeList.size() + entities.size());
+    for (Entity e : entities) {
+        destroy(e);
+    }
+}
+
 void Registry::clear() {
-    for (auto& kv : m_pools) {
-        kv.second->clear();
+    assert(!structureLocked() && "Structural change during parallelEach!");
+    checkStructural("clear");
+    for (auto& pool : m_pools) {
+        if (pool) pool->clear();
     }
     m_pools.clear();
+    m_motion.clear();
+    m_groups.clear();
+    m_poolOwner.clear();
     m_slots.clear();
     m_freeList.clear();
     m_aliveCount = 0;
 }
 
+// ────────────────────────────────────────────────────────────────
+// Owning groups
+// ────────────────────────────────────────────────────────────────
+
+const Registry::GroupData& Registry::acquireGroup(std::vector<ComponentTypeId> owned) {
+    std::sort(owned.begin(), owned.end());
+    assert(std::adjacent_find(owned.begin(), owned.end()) == owned.end() &&
+           "Group component types must be unique!");
+
+    for (const auto& g : m_groups) {
+        if (g->owned == owned) return *g;
+    }
+    assert(!structureLocked() && "Structural change during parallelEach!");
+    assert(!inParallelSystem() && "Group created by a system running in parallel!");
+
+    // Un pool solo puede tener un dueño: dos grupos no pueden ordenar
+    // el mismo dense array de formas distintas.
+    if (m_poolOwner.size() < m_pools.size()) {
+        m_poolOwner.resize(m_pools.size(), nullptr);
+    }
+    for (ComponentTypeId id : owned) {
+        assert(m_poolOwner[id] == nullptr && "Component pool already owned by another group!");
+    }
+
+    auto group = std::make_unique<GroupData>();
+    group->owned = std::move(owned);
+    GroupData& g = *group;
+    m_groups.push_back(std::move(group));
+
+    for (ComponentTypeId id : g.owned) {
+        m_poolOwner[id] = &g;
+    }
+
+    // Empaquetar las entidades que ya tienen todos los componentes.
+    // Recorremos el pool mas chico; groupTryAdd solo mueve entidades hacia
+    // posiciones < i (ya visitadas), asi que el recorrido no se saltea nada.
+    IComponentPool* driver = m_pools[g.owned.front()].get();
+    for (ComponentTypeId id : g.owned) {
+        if (m_pools[id]->size() < driver->size()) driver = m_pools[id].get();
+    }
+    for (size_t i = 0; i < driver->size(); ++i) {
+        groupTryAdd(g, driver->denseEntities()[i]);
+    }
+
+    return g;
+}
+
+void Registry::groupTryAdd(GroupData& g, Entity e) {
+    // Tiene que tener todos los componentes y no estar ya empaquetada.
+    for (ComponentTypeId id : g.owned) {
+        uint32_t idx = m_pools[id]->denseIndex(e);
+        if (idx == IComponentPool::InvalidDense || idx < g.size) return;
+    }
+
+    // Moverla a la posicion g.size de cada pool y agrandar la zona.
+    const uint32_t pos = static_cast<uint32_t>(g.size);
+    for (ComponentTypeId id : g.owned) {
+        IComponentPool& pool = *m_pools[id];
+        pool.swapDense(pool.denseIndex(e), pos);
+    }
+    ++g.size;
+}
+
+void Registry::groupRemove(GroupData& g, Entity e) {
+    // Si esta en el grupo, esta en [0, size) de TODOS los pools del grupo.
+    uint32_t idx = m_pools[g.owned.front()]->denseIndex(e);
+    if (idx == IComponentPool::InvalidDense || idx >= g.size) return;
+
+    // Achicar la zona y mover a e justo afuera (la ultima posicion del
+    // grupo). El swap-remove posterior del pool no toca la zona empaquetada.
+    --g.size;
+    const uint32_t pos = static_cast<uint32_t>(g.size);
+    for (ComponentTypeId id : g.owned) {
+        IComponentPool& pool = *m_pools[id];
+        pool.swapDense(pool.denseIndex(e), pos);
+    }
+}
+
+void Registry::groupSwap(GroupData& g, uint32_t a, uint32_t b) {
+    for (ComponentTypeId id : g.owned) {
+        m_pools[id]->swapDense(a, b);
+    }
+}
+
 } // namespace eng::ecs
@@ -1,16 +1,233 @@
 #include "engine/ecs/SystemScheduler.h"
 #include <algorithm>
+#include <cassert>
 
 namespace eng::ecs {
 
 void SystemScheduler::runPhase(Phase phase, Registry& reg, float dtOrAlpha) {
-    for (auto& s : m_systems) {
-        if (s.phase != phase) continue;
-        if (!s.enabled) continue;
+    if (m_graphsDirty) buildGraphs();
+    PhaseGraph& graph = m_graphs[static_cast<size_t>(phase)];
+
+    // Que sistemas corren este tick y con que dt/slice se decide aca, en
+    // el thread que llama, antes de lanzar nada.
+    for (uint32_t index : graph.nodes) scheduleRun(m_systems[index], phase, dtOrAlpha);
+
+    // La primera corrida de cada sistema es en serie: los pools y grupos
+    // que crea la primera vez que los pide (group<...>(), get<T>()) se crean
+    // sin nadie corriendo al lado. Mientras le toque correr a alguno que
+    // todavia no corrio (recien agregado, o desactivado hasta ahora) la
+    // fase entera va en serie.
+    bool cold = false;
+    for (uint32_t index : graph.nodes) {
+        const System& s = m_systems[index];
+        if (s.enabled && s.due && !s.warmedUp) cold = true;
+    }
+
+    JobSystem* jobs = reg.ctx().jobs;
+    if (m_parallel && jobs && jobs->workerCount() > 0 && !cold) {
+        for (const Segment& segment : graph.segments) {
+            if (segment.parallel) {
+                runParallel(graph, segment, reg, *jobs);
+            } else {
+                runSerial(graph, segment.begin, segment.end, reg);
+            }
+        }
+    } else {
+        runSerial(graph, 0, static_cast<uint32_t>(graph.nodes.size()), reg);
+    }
+
+    // Limite de fase: aplicar los cambios estructurales diferidos que
+    // grabaron los sistemas (nadie esta iterando ahora).
+    if (!m_commands.empty()) {
+        eng::ScopeTimer t(m_profiler, m_commandsZone);
+        // Tick propio: lo que aplica el playback lo ven como nuevo incluso
+        // los sistemas que lo grabaron.
+        reg.advanceTick();
+        m_commands.playback(reg);
+    }
+}
+
+void SystemScheduler::runSerial(PhaseGraph& graph, uint32_t begin, uint32_t end, Registry& reg) {
+    for (uint32_t node = begin; node < end; ++node) {
+        System& s = m_systems[graph.nodes[node]];
+        if (!s.enabled || !s.due) continue;
+
+        eng::ScopeTimer t(m_profiler, s.zone);
+        // Change tracking: lo que el sistema modifique queda con un tick
+        // nuevo, y sus filtros changed/added comparan contra su corrida anterior.
+        reg.setLastRunTick(beginRun(s, reg));
+        reg.setTimeSlice(s.runSlice);
+        invoke(s, reg);
+        reg.setTimeSlice({});
+        s.warmedUp = true;
+    }
+}
+
+void SystemScheduler::runParallel(PhaseGraph& graph, const Segment& segment, Registry& reg, JobSystem& jobs) {
+    PhaseRun run;
+    run.graph = &graph;
+    run.reg = &reg;
+    run.jobs = &jobs;
+    for (uint32_t i = segment.begin; i < segment.end; ++i) {
+        graph.pending[i].store(graph.predecessorCount[i], std::memory_order_relaxed);
+    }
 
-        eng::ScopeTimer t(m_profiler, s.name);
-        s.fn(reg, dtOrAlpha);
+    // Arrancan los nodos sin predecesores; cada uno lanza a sus sucesores
+    // cuando es el ultimo predecesor en terminar. Este thread ayuda a
+    // correrlos mientras espera.
+    for (uint32_t i = segment.begin; i < segment.end; ++i) {
+        if (graph.predecessorCount[i] == 0) launchNode(run, i);
     }
+    jobs.wait(run.done);
+}
+
+void SystemScheduler::launchNode(PhaseRun& run, uint32_t node) {
+    run.jobs->run([this, &run, node] { runNode(run, node); }, &run.done);
+}
+
+void SystemScheduler::runNode(PhaseRun& run, uint32_t node) {
+    PhaseGraph& graph = *run.graph;
+    System& s = m_systems[graph.nodes[node]];
+
+    // Un sistema desactivado (o que no le toca este tick) igual libera a
+    // sus sucesores.
+    if (s.enabled && s.due) {
+        // El Profiler acepta samples desde cualquier thread.
+        eng::ScopeTimer t(m_profiler, s.zone);
+
+        // Mismo change tracking que en serie, pero lastRunTick, slice y
+        // tick de escritura por thread: otros sistemas corren a la vez
+        // sobre el mismo registry y avanzan el tick global.
+        const uint32_t since = beginRun(s, *run.reg);
+        Registry::SystemRunScope runScope(*run.reg, s.lastRunTick, since, s.runSlice);
+        invoke(s, *run.reg);
+    }
+
+    for (uint32_t next : graph.successors[node]) {
+        if (graph.pending[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            launchNode(run, next);
+        }
+    }
+}
+
+void SystemScheduler::invoke(System& s, Registry& reg) {
+    detail::AccessGuard guard{s.name.c_str(), &s.access, &s.reported, &m_violations};
+    const bool validate = m_validateAccess && s.access.declared();
+    detail::AccessGuardScope scope(validate ? &guard : nullptr);
+    s.fn(reg, s.runDt);
+}
+
+void SystemScheduler::scheduleRun(System& s, Phase phase, float dtOrAlpha) {
+    s.due = false;
+
+    // Desactivado no acumula: al reactivarlo no recibe de golpe el dt de
+    // todo el tiempo que estuvo apagado.
+    if (!s.enabled) {
+        s.skippedTicks = 0;
+        s.skippedDt = 0.0f;
+        std::fill(s.sliceDt.begin(), s.sliceDt.end(), 0.0f);
+        return;
+    }
+
+    // Render recibe alpha (interpolacion), que no se suma.
+    const bool accumulate = phase != Phase::Render;
+    s.skippedDt = accumulate ? s.skippedDt + dtOrAlpha : dtOrAlpha;
+
+    // Corre en el primer tick y despues cada rateDivisor: asi su primera
+    // corrida cae en la corrida en serie de la fase (ver runPhase).
+    if (s.skippedTicks > 0) {
+        --s.skippedTicks;
+        return;
+    }
+    s.skippedTicks = s.rateDivisor - 1;
+    const float dt = s.skippedDt;
+    s.skippedDt = 0.0f;
+    s.due = true;
+
+    if (s.sliceCount <= 1) {
+        s.runDt = dt;
+        s.runSlice = TimeSlice{};
+        return;
+    }
+
+    // Cada slice acumula el dt de todas las corridas hasta que le vuelve
+    // a tocar.
+    const uint32_t slice = s.nextSlice;
+    s.nextSlice = (slice + 1) % s.sliceCount;
+    for (float& sliceDt : s.sliceDt) sliceDt = accumulate ? sliceDt + dt : dt;
+    s.runDt = s.sliceDt[slice];
+    s.sliceDt[slice] = 0.0f;
+    s.runSlice = TimeSlice{slice, s.sliceCount};
+}
+
+uint32_t SystemScheduler::beginRun(System& s, Registry& reg) {
+    const uint32_t tick = reg.advanceTick();
+    uint32_t since = s.lastRunTick;
+    if (!s.runSlice.all()) {
+        // Con time-slicing las entidades de este slice no se vieron desde
+        // la ultima corrida de ESTE slice.
+        since = s.sliceRunTick[s.runSlice.index];
+        s.sliceRunTick[s.runSlice.index] = tick;
+    }
+    s.lastRunTick = tick;
+    return since;
+}
+
+void SystemScheduler::buildGraphs() {
+    for (auto& graph : m_graphs) {
+        graph.nodes.clear();
+        graph.segments.clear();
+    }
+
+    // m_systems esta ordenado por fase y prioridad: los nodos de cada
+    // grafo quedan en orden de prioridad.
+    for (uint32_t i = 0; i < m_systems.size(); ++i) {
+        m_graphs[static_cast<size_t>(m_systems[i].phase)].nodes.push_back(i);
+    }
+
+    for (auto& graph : m_graphs) {
+        const uint32_t n = static_cast<uint32_t>(graph.nodes.size());
+        graph.successors.assign(n, {});
+        graph.predecessorCount.assign(n, 0);
+        graph.pending = std::make_unique<std::atomic<uint32_t>[]>(n);
+
+        auto accessOf = [&](uint32_t node) -> const SystemAccess& {
+            return m_systems[graph.nodes[node]].access;
+        };
+
+        for (uint32_t begin = 0; begin < n;) {
+            Segment segment;
+            segment.begin = begin;
+            if (!accessOf(begin).declared()) {
+                segment.end = begin + 1;
+                graph.segments.push_back(segment);
+                begin = segment.end;
+                continue;
+            }
+
+            uint32_t end = begin;
+            while (end < n && accessOf(end).declared()) ++end;
+            segment.end = end;
+
+            // Si cada nodo choca con el siguiente el orden es total y no
+            // hay nada que paralelizar.
+            bool chain = true;
+            for (uint32_t i = begin; i < end; ++i) {
+                for (uint32_t j = i + 1; j < end; ++j) {
+                    if (!accessOf(i).conflictsWith(accessOf(j))) {
+                        if (j == i + 1) chain = false;
+                        continue;
+                    }
+                    graph.successors[i].push_back(j);
+                    graph.predecessorCount[j]++;
+                }
+            }
+            segment.parallel = !chain;
+            graph.segments.push_back(segment);
+            begin = end;
+        }
+    }
+    m_graphsDirty = false;
 }
 
 void SystemScheduler::fixedUpdate(Registry& reg, float fixedDt) {
@@ -26,8 +243,15 @@ void SystemScheduler::render(Registry& reg, float alpha) {
 }
 
 void SystemScheduler::addSystem(std::string name, Phase phase, int priority,
-                                std::function<void(Registry&, float)> fn) {
-    m_systems.push_back(System{ std::move(name), phase, priority, true, std::move(fn) });
+                                std::function<void(Registry&, float)> fn, SystemAccess access) {
+    System s;
+    s.name = std::move(name);
+    s.phase = phase;
+    s.priority = priority;
+    s.fn = std::move(fn);
+    s.access = access;
+    s.zone = m_profiler.registerZone(s.name);
+    m_systems.push_back(std::move(s));
     sortSystems();
 }
 
@@ -38,6 +262,35 @@ void SystemScheduler::sortSystems() {
             if (a.priority != b.priority) return a.priority < b.priority; // prioridad
             return a.name < b.name; // desempate estable
         });
+    m_graphsDirty = true;
+}
+
+System* SystemScheduler::findSystem(const std::string& name) {
+    for (auto& s : m_systems) {
+        if (s.name == name) return &s;
+    }
+    return nullptr;
+}
+
+bool SystemScheduler::setRate(const std::string& name, uint32_t divisor) {
+    assert(divisor > 0 && "Rate divisor must be at least 1!");
+    System* s = findSystem(name);
+    if (!s) return false;
+    s->rateDivisor = divisor;
+    s->skippedTicks = std::min(s->skippedTicks, divisor - 1);
+    return true;
+}
+
+bool SystemScheduler::setTimeSlices(const std::string& name, uint32_t slices) {
+    assert(slices > 0 && "Time slice count must be at least 1!");
+    System* s = findSystem(name);
+    if (!s) return false;
+    s->sliceCount = slices;
+    s->nextSlice = 0;
+    // Los slices nuevos arrancan desde la ultima corrida del sistema.
+    s->sliceDt.assign(slices > 1 ? slices : 0, 0.0f);
+    s->sliceRunTick.assign(slices > 1 ? slices : 0, s->lastRunTick);
+    return true;
 }
 
 bool SystemScheduler::setEnabled(const std::string& name, bool enabled) {
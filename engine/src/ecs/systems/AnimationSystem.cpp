@@ -1,33 +1,54 @@
 #include "engine/ecs/systems/AnimationSystem.h"
 #include "engine/ecs/Components.h"
+#include "engine/render/AnimationLibrary.h"
 
 namespace eng::ecs::systems {
 
 void AnimationSystem(Registry& reg, float dt) {
-    // Iterar todas las entidades que tienen SpriteAnimator Y Sprite.
-    // El sistema avanza el timer, cambia de frame, y actualiza el uvRect del Sprite.
-    auto view = reg.view<SpriteAnimator, Sprite>();
+    // Los clips estan en el AnimationLibrary compartido; cada SpriteAnimator
+    // es un POD chico (handle + clip + frame + timer), asi que el pool que
+    // se recorre es compacto.
+    AnimationLibrary* library = reg.ctx().animations;
+    if (!library) return;
+
+    // Con time-slicing (scheduler.setTimeSlices) cada corrida procesa las
+    // entidades de un slice y dt es el acumulado de ese slice; el reloj
+    // avanza una vez por vuelta, con el dt del slice 0.
+    const TimeSlice slice = reg.timeSlice();
 
-    for (auto [e, animator, sprite] : view) {
-        if (!animator.playing) continue;
-        if (animator.clips.empty()) continue;
+    // Los TimedSpriteAnimator no se tocan aca: solo avanza el reloj y
+    // RenderSystem calcula su frame al dibujarlos.
+    if (slice.index == 0) library->advanceClock(dt);
 
-        auto& clip = animator.clips[animator.currentClip];
-        if (clip.frames.empty()) continue;
+    // Iterar todas las entidades que tienen SpriteAnimator Y Sprite.
+    // El sistema avanza el timer, cambia de frame, y actualiza el uvRect del Sprite.
+    // Owning group: animator y sprite de cada entidad estan en la misma
+    // posicion de sus dense arrays (sin lookups de sparse). Cada entidad es
+    // independiente, asi que se reparte en rangos entre los workers.
+    // slice(): solo las entidades de este slice (y solo esas quedan
+    // marcadas como cambiadas).
+    reg.group<SpriteAnimator, Sprite>().slice(slice).parallelEach([dt, library](SpriteAnimator& animator,
+                                                                               Sprite& sprite) {
+        if (!animator.playing) return;
+        if (!library->valid(animator.clipSet)) return;
+        if (animator.currentClip >= library->clipCount(animator.clipSet)) return;
+
+        const AnimationLibrary::Clip& clip = library->clip(animator.clipSet, animator.currentClip);
+        if (clip.frameCount == 0) return;
 
         // Avanzar timer
-        animator.timer += dt;
+        animator.timer += dt * animator.speed;
 
         // Cambiar de frame si paso suficiente tiempo
         while (animator.timer >= clip.frameDuration) {
             animator.timer -= clip.frameDuration;
             animator.currentFrame++;
 
-            if (animator.currentFrame >= (int)clip.frames.size()) {
+            if (animator.currentFrame >= clip.frameCount) {
                 if (clip.loop) {
                     animator.currentFrame = 0;
                 } else {
-                    animator.currentFrame = (int)clip.frames.size() - 1;
+                    animator.currentFrame = static_cast<uint16_t>(clip.frameCount - 1);
                     animator.playing = false;
                     break;
                 }
@@ -35,8 +56,8 @@ void AnimationSystem(Registry& reg, float dt) {
         }
 
         // Actualizar el UV del sprite con el frame actual
-        sprite.uvRect = clip.frames[animator.currentFrame];
-    }
+        sprite.uvRect = library->frame(clip, animator.currentFrame);
+    });
 }
 
 } // namespace eng::ecs::systems
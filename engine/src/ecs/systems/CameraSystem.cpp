@@ -17,7 +17,7 @@ void CameraSystem(Registry& reg, float alpha) {
     constexpr float kPPU = 64.0f;
     // Buscar el player para obtener su posicion interpolada como target
     glm::vec2 target{0.0f, 0.0f};
-    auto pv = reg.view<PlayerTag, Transform2D>();
+    auto pv = reg.view<PlayerTag, const Transform2D>();
     if (pv.valid()) {
         auto [e, tag, t] = *pv.begin();
         (void)e; (void)tag;
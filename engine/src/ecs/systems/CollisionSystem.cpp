@@ -1,11 +1,13 @@
 #include "engine/ecs/systems/CollisionSystem.h"
 #include "engine/ecs/Components.h"
+#include "engine/Profiling.h"
 
 #include <unordered_map>
 #include <vector>
 #include <cmath>
 #include <algorithm>
 #include <cstdint>
+#include <utility>
 
 namespace eng::ecs::systems {
 
@@ -180,24 +182,32 @@ static void resolveTileCollisions(glm::vec2& pos,
 // CollisionSystem
 // ────────────────────────────────────────────────────────────────
 
+static eng::ProfileZone s_gridZone("Collision/BuildGrid");
+static eng::ProfileZone s_tilesZone("Collision/Tiles");
+static eng::ProfileZone s_entitiesZone("Collision/Entities");
+
 void CollisionSystem(Registry& reg, float /*dt*/) {
+    eng::Profiler* profiler = reg.ctx().profiler;
+
     // ── 1. Construir spatial grid con todas las entidades con collider ──
     SpatialGrid grid;
-
-    auto allColliders = reg.view<Transform2D, BoxCollision>();
-    for (auto [e, t, b] : allColliders) {
-        if (!b.isSolid) continue;
-        AABB box = makeAABB(t, b);
-        insertIntoGrid(grid, e, box);
+    {
+        eng::ScopeTimer timer(profiler, s_gridZone);
+        auto allColliders = reg.view<const Transform2D, const BoxCollision>();
+        for (auto [e, t, b] : allColliders) {
+            if (!b.isSolid) continue;
+            AABB box = makeAABB(t, b);
+            insertIntoGrid(grid, e, box);
+        }
     }
 
     // ── 2. Buscar tilemap y tile collision layer ──
     // (puede haber 0 o 1 tilemap en la escena)
-    Transform2D* tmTransform = nullptr;
-    Tilemap*     tmPtr = nullptr;
-    TileCollisionLayer* tclPtr = nullptr;
+    const Transform2D* tmTransform = nullptr;
+    const Tilemap*     tmPtr = nullptr;
+    const TileCollisionLayer* tclPtr = nullptr;
     {
-        auto tmView = reg.view<Transform2D, Tilemap, TileCollisionLayer>();
+        auto tmView = reg.view<const Transform2D, const Tilemap, const TileCollisionLayer>();
         if (tmView.valid()) {
             auto [e, t, tm, tcl] = *tmView.begin();
             (void)e;
@@ -208,17 +218,24 @@ void CollisionSystem(Registry& reg, float /*dt*/) {
     }
 
     // ── 3. Para cada entidad movil, resolver colisiones ──
-    auto movers = reg.view<Transform2D, Velocity2D, BoxCollision>();
+    // Tiles y entidades se alternan por entidad: cada parte se mide con
+    // ticks y se manda sumada (un sample por frame, no uno por entidad).
+    auto movers = reg.view<Transform2D, const Velocity2D, const BoxCollision>();
     std::vector<Entity> nearby;
+    uint64_t tileTicks = 0;
+    uint64_t entityTicks = 0;
 
     for (auto [e, t, v, b] : movers) {
         if (!b.isSolid) continue;
 
         // 3a. Colision contra tiles solidos
+        const uint64_t tileStart = profiler ? SDL_GetPerformanceCounter() : 0;
         if (tmPtr && tclPtr && tmTransform) {
             resolveTileCollisions(t.position, b, *tmPtr, *tclPtr,
                                   tmTransform->position);
         }
+        const uint64_t entityStart = profiler ? SDL_GetPerformanceCounter() : 0;
+        tileTicks += entityStart - tileStart;
 
         // 3b. Colision contra entidades solidas cercanas
         AABB myBox = makeAABB(t, b);
@@ -230,10 +247,10 @@ void CollisionSystem(Registry& reg, float /*dt*/) {
 
             // Solo contra entidades solidas
             if (!reg.has<BoxCollision>(other)) continue;
-            auto& otherB = reg.get<BoxCollision>(other);
+            auto& otherB = std::as_const(reg).get<BoxCollision>(other);
             if (!otherB.isSolid) continue;
 
-            auto& otherT = reg.get<Transform2D>(other);
+            auto& otherT = std::as_const(reg).get<Transform2D>(other);
             AABB otherBox = makeAABB(otherT, otherB);
 
             // Recalcular mi AABB (pudo cambiar por resoluciones previas)
@@ -269,6 +286,13 @@ void CollisionSystem(Registry& reg, float /*dt*/) {
             t.position.x += resolveX;
             t.position.y += resolveY;
         }
+
+        if (profiler) entityTicks += SDL_GetPerformanceCounter() - entityStart;
+    }
+
+    if (profiler) {
+        profiler->submit(s_tilesZone.id(*profiler), eng::Profiler::ticksToMs(tileTicks));
+        profiler->submit(s_entitiesZone.id(*profiler), eng::Profiler::ticksToMs(entityTicks));
     }
 }
 
@@ -2,17 +2,54 @@
 #include "engine/ecs/Components.h"
 #include "engine/ecs/SystemScheduler.h"
 #include "engine/Profiling.h"
+#include "engine/render/Renderer2D.h"
 #include "engine/Input.h"
 #include "engine/Time.h"
 
 #include <imgui.h>
 #include <SDL.h>
 
+#include <cstdint>
+#include <utility>
+
 namespace eng::ecs::systems {
 
+/// Una zona del profiler y sus hijas (las que la tenian abierta en su
+/// ultimo sample). depth corta ciclos si una zona se anida en si misma.
+static void drawZoneTree(const eng::Profiler& profiler, eng::Profiler::ZoneId zone, int depth) {
+    const auto& st = profiler.stats(zone);
+    if (st.samples == 0) return;
+
+    bool hasChildren = false;
+    for (eng::Profiler::ZoneId child = 0; child < profiler.zoneCount(); ++child) {
+        if (child != zone && profiler.parent(child) == zone) {
+            hasChildren = true;
+            break;
+        }
+    }
+
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_DefaultOpen;
+    if (!hasChildren || depth >= 8) flags |= ImGuiTreeNodeFlags_Leaf;
+    const bool open = ImGui::TreeNodeEx(
+        reinterpret_cast<void*>(static_cast<uintptr_t>(zone)), flags,
+        "%s | last: %.3f ms | avg: %.3f ms | min: %.3f | max: %.3f | n=%zu",
+        profiler.zoneName(zone).c_str(), st.lastMs, st.avgMs, st.minMs, st.maxMs, st.samples
+    );
+    if (!open) return;
+    if (hasChildren && depth < 8) {
+        for (eng::Profiler::ZoneId child = 0; child < profiler.zoneCount(); ++child) {
+            if (child != zone && profiler.parent(child) == zone) drawZoneTree(profiler, child, depth + 1);
+        }
+    }
+    ImGui::TreePop();
+}
+
 void DebugUISystem(Registry& reg, float /*dt*/) {
     auto& ctx = reg.ctx();
 
+    // Headless (EngineConfig::headless): no hay ImGui.
+    if (!ImGui::GetCurrentContext()) return;
+
     ImGui::Begin("Debug");
 
     ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
@@ -24,7 +61,7 @@ void DebugUISystem(Registry& reg, float /*dt*/) {
 
     auto e0 = Entity{0, 0};
     if (reg.isAlive(e0) && reg.has<Transform2D>(e0)) {
-        auto& t = reg.get<Transform2D>(e0);
+        const auto& t = std::as_const(reg).get<Transform2D>(e0);
         ImGui::Text("E0 pos: (%.2f, %.2f)", t.position.x, t.position.y);
     }
 
@@ -34,27 +71,68 @@ void DebugUISystem(Registry& reg, float /*dt*/) {
     if (ctx.profiler) {
         auto* profiler = ctx.profiler;
         static int window = (int)profiler->window();
-        ImGui::SliderInt("Profiler window", &window, 10, 600);
+        ImGui::SliderInt("Profiler window", &window, 10, (int)profiler->maxWindow());
         profiler->setWindow((size_t)window);
 
         ImGui::Separator();
         ImGui::Text("Profiler (rolling window: %zu)", profiler->window());
 
-        for (const auto& kv : profiler->stats()) {
-            const auto& name = kv.first;
-            const auto& st = kv.second;
+        for (eng::Profiler::ZoneId zone = 0; zone < profiler->zoneCount(); ++zone) {
+            if (profiler->isCounter(zone)) continue;
+            const eng::Profiler::ZoneId parent = profiler->parent(zone);
+            if (parent == eng::Profiler::InvalidZone || parent == zone) drawZoneTree(*profiler, zone, 0);
+        }
+        if (profiler->dropped() > 0) {
+            ImGui::Text("Dropped samples: %llu", static_cast<unsigned long long>(profiler->dropped()));
+        }
+
+        // Captura de N frames como Chrome trace (Perfetto / chrome://tracing)
+        static int traceFrames = 120;
+        ImGui::SliderInt("Trace frames", &traceFrames, 1, 600);
+        if (profiler->capturing()) {
+            ImGui::Text("Capturing trace... %zu frames left", profiler->traceFramesLeft());
+        } else if (ImGui::Button("Capture trace")) {
+            profiler->captureTrace((size_t)traceFrames, "trace.json");
+        }
+        if (!profiler->lastTrace().empty()) {
+            ImGui::Text("Last trace: %s", profiler->lastTrace().c_str());
+        }
 
-            ImGui::BulletText(
-                "%s | last: %.3f ms | avg: %.3f ms | min: %.3f | max: %.3f | n=%zu",
-                name.c_str(), st.lastMs, st.avgMs, st.minMs, st.maxMs, st.samples
-            );
+        // Contadores (por frame, sobre la misma ventana)
+        bool anyCounter = false;
+        for (eng::Profiler::ZoneId zone = 0; zone < profiler->zoneCount(); ++zone) {
+            const auto& st = profiler->stats(zone);
+            if (!profiler->isCounter(zone) || st.samples == 0) continue;
+            if (!anyCounter) {
+                ImGui::Separator();
+                ImGui::Text("Counters (per frame)");
+                anyCounter = true;
+            }
+            ImGui::BulletText("%s | last: %.0f | avg: %.1f | min: %.0f | max: %.0f",
+                              profiler->zoneName(zone).c_str(), st.lastMs, st.avgMs, st.minMs, st.maxMs);
         }
     }
 
+    // Renderer (ultimo frame cerrado)
+    if (ctx.renderer) {
+        const eng::RendererStats rs = ctx.renderer->stats();
+        ImGui::Separator();
+        ImGui::Text("Renderer: %u draw calls | %u flushes | %u slot overflows",
+                    rs.drawCalls, rs.flushes, rs.slotOverflows);
+        ImGui::Text("%u quads | %u vertices | %u texture binds | %.1f KB uploaded",
+                    rs.quads, rs.vertices, rs.textureBinds, static_cast<double>(rs.uploadBytes) / 1024.0);
+    }
+
     // Scheduler / systems list
     if (ctx.scheduler) {
         auto* scheduler = ctx.scheduler;
         ImGui::Separator();
+        bool parallel = scheduler->parallel();
+        if (ImGui::Checkbox("Parallel systems", &parallel)) scheduler->setParallel(parallel);
+        ImGui::SameLine();
+        bool validate = scheduler->validateAccess();
+        if (ImGui::Checkbox("Validate access", &validate)) scheduler->setValidateAccess(validate);
+        ImGui::Text("Access violations: %u", scheduler->accessViolations());
         ImGui::Text("Systems order:");
         for (const auto& s : scheduler->systems()) {
             bool enabled = s.enabled;
@@ -70,6 +148,10 @@ void DebugUISystem(Registry& reg, float /*dt*/) {
                 s.priority,
                 s.name.c_str()
             );
+            if (s.rateDivisor > 1 || s.sliceCount > 1) {
+                ImGui::SameLine();
+                ImGui::TextDisabled("(1/%u rate, %u slices)", s.rateDivisor, s.sliceCount);
+            }
             ImGui::PopID();
         }
     }
@@ -87,7 +169,7 @@ void DebugUISystem(Registry& reg, float /*dt*/) {
 
     // Player position
     ImGui::Separator();
-    auto view = reg.view<PlayerTag, Transform2D>();
+    auto view = reg.view<PlayerTag, const Transform2D>();
     if (view.valid()) {
         auto [e, tag, t] = *view.begin();
         (void)e; (void)tag;
@@ -4,11 +4,25 @@
 namespace eng::ecs::systems {
 
 void MovementSystem(Registry& reg, float dt) {
-    auto view = reg.view<Transform2D, Velocity2D>();
-    for (auto [e, t, v] : view) {
+    // Owning group: Transform2D y Velocity2D quedan empaquetados en lockstep,
+    // el loop es un recorrido lineal de dos arrays paralelos (en paralelo
+    // por rangos si hay job system). Velocity2D es const: solo Transform2D
+    // queda marcado como cambiado.
+    reg.group<Transform2D, const Velocity2D>().parallelEach([dt](Transform2D& t, const Velocity2D& v) {
         t.prevPosition = t.position;
         t.position.x += v.velocity.x * dt;
         t.position.y += v.velocity.y * dt;
+    });
+
+    // Entidades en layout SoA (opt-in): kernel SIMD sobre arrays de floats,
+    // un slice del stream por rango.
+    const MotionStreams streams = reg.motion().streams();
+    if (JobSystem* jobs = reg.ctx().jobs) {
+        jobs->parallelFor(streams.count, Registry::DefaultGrainSize * 4, [&](size_t begin, size_t end) {
+            integrateMotion(streams.slice(begin, end), dt);
+        });
+    } else {
+        integrateMotion(streams, dt);
     }
 }
 
@@ -37,7 +37,7 @@ void PlayerControlSystem(Registry& reg, float /*fixedDt*/) {
         if (reg.has<SpriteAnimator>(e) && reg.has<Sprite>(e)) {
             auto& animator = reg.get<SpriteAnimator>(e);
             auto& sprite   = reg.get<Sprite>(e);
-            int newClip = 0; // idle por defecto
+            uint16_t newClip = 0; // idle por defecto
 
             if (len2 > 0.0f) {
                 // Hay movimiento — elegir clip segun la direccion predominante
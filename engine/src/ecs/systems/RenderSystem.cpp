@@ -3,37 +3,48 @@
 #include "engine/ecs/Components.h"
 #include "engine/render/Renderer2D.h"
 #include "engine/render/TextureManager.h"
+#include "engine/render/AnimationLibrary.h"
 #include "engine/Math.h"
+#include "engine/Profiling.h"
 
 #include <SDL.h>
-#include <vector>
-#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace eng::ecs::systems {
 
 using eng::lerp;
 using eng::lerpVec2;
 
+static eng::ProfileZone s_quadsZone("Render/Quads");
+static eng::ProfileZone s_tilemapZone("Render/Tilemap");
+static eng::ProfileZone s_sortZone("Render/SortSprites");
+static eng::ProfileZone s_spritesZone("Render/DrawSprites");
+static eng::ProfileZone s_flushZone("Render/Flush");
+
 void RenderSystem(Registry& reg, float alpha) {
     // Obtener window y renderer del contexto del registry (sin globals)
     auto& ctx = reg.ctx();
-    int w = 1, h = 1;
-    SDL_GetWindowSize(ctx.window, &w, &h);
-
     auto& r = *ctx.renderer;
+
+    // Sin ventana (Renderer2D con NullRenderBackend): tamano fijo del renderer.
+    int w = r.targetWidth(), h = r.targetHeight();
+    if (ctx.window) SDL_GetWindowSize(ctx.window, &w, &h);
     r.beginFrame(w, h);
 
-    auto view = reg.view<Transform2D, RenderQuad>();
-    for (auto [e, t, rq] : view) {
-        glm::vec2 renderPos = lerpVec2(t.prevPosition, t.position, alpha);
-        r.submitQuad({renderPos.x, renderPos.y}, rq.w, rq.h, rq.color);
+    {
+        eng::ScopeTimer timer(ctx.profiler, s_quadsZone);
+        reg.view<const Transform2D, const RenderQuad>().each([&](const Transform2D& t, const RenderQuad& rq) {
+            glm::vec2 renderPos = lerpVec2(t.prevPosition, t.position, alpha);
+            r.submitQuad({renderPos.x, renderPos.y}, rq.w, rq.h, rq.color);
+        });
+        r.flush();
     }
-    r.flush();
     // Leer posicion de la camara (ya actualizada por CameraSystem)
     constexpr float kPPU = 64.0f;
     glm::vec2 camPos{0.0f, 0.0f};
     {
-        auto camView = reg.view<Camera>();
+        auto camView = reg.view<const Camera>();
         if (camView.valid()) {
             auto [e, cam] = *camView.begin();
             (void)e;
@@ -42,50 +53,113 @@ void RenderSystem(Registry& reg, float alpha) {
     }
 
     // ── Tilemap (entre quads de color y sprites) ──
-    TilemapRenderSystem(reg, alpha, camPos, w, h, kPPU);
+    {
+        eng::ScopeTimer timer(ctx.profiler, s_tilemapZone);
+        TilemapRenderSystem(reg, alpha, camPos, w, h, kPPU);
+    }
 
     // ── Capa 1: sprites texturizados (Y-sorted para profundidad) ──
-    // Recolectar sprites con su sortY (borde inferior = pies).
-    // Entidades con Y mayor (mas abajo en pantalla) se dibujan despues (encima).
-    struct SpriteEntry {
-        float      sortY;      // Y del borde inferior del sprite (los "pies")
-        glm::vec2  renderPos;
-        uint32_t   glId;
-        eng::Rect  uv;
-        float      width, height;
-        eng::ecs::Color4 tint;
+    // Profundidad = borde inferior del sprite (los "pies") en la posicion
+    // interpolada. Entidades con Y mayor (mas abajo en pantalla) se dibujan
+    // despues (encima). Sprites sin posicion (ni Transform2D ni SoA) no se
+    // dibujan y quedan al final.
+    const Registry& creg = reg;
+    const SoAMotionPool& motion = creg.motion();
+
+    auto spritePosition = [&](Entity e, glm::vec2& out) -> bool {
+        if (creg.has<Transform2D>(e)) {
+            const auto& t = creg.get<Transform2D>(e);
+            out = lerpVec2(t.prevPosition, t.position, alpha);
+            return true;
+        }
+        if (motion.has(e)) {
+            out = lerpVec2(motion.prevPosition(e), motion.position(e), alpha);
+            return true;
+        }
+        return false;
+    };
+
+    auto sortY = [&](Entity e) -> float {
+        glm::vec2 pos;
+        if (!spritePosition(e, pos)) return std::numeric_limits<float>::infinity();
+        return pos.y + creg.get<Sprite>(e).height * 0.5f;
     };
-    std::vector<SpriteEntry> spriteEntries;
 
-    auto spriteView = reg.view<Transform2D, Sprite>();
-    for (auto [e, t, spr] : spriteView) {
-        glm::vec2 renderPos = lerpVec2(t.prevPosition, t.position, alpha);
-        uint32_t glId = ctx.textures->glId(spr.texture);
+    // El orden del pool se conserva entre frames y cambia poco: el
+    // insertion sort sobre datos casi ordenados es ~O(n), sin copias.
+    {
+        eng::ScopeTimer timer(ctx.profiler, s_sortZone);
+        reg.sort<Sprite>([&](Entity a, Entity b) { return sortY(a) < sortY(b); });
+    }
+
+    const ComponentPool<Sprite>* sprites = creg.storage<Sprite>();
+    if (!sprites) {
+        r.flush();
+        return;
+    }
+
+    // Rect visible en world coords: los sprites que caen afuera no se
+    // dibujan (ni se resuelve su animacion).
+    const float halfW = static_cast<float>(w) / kPPU * 0.5f;
+    const float halfH = static_cast<float>(h) / kPPU * 0.5f;
+
+    // Animaciones sin estado: el frame sale del reloj del library, solo
+    // para los sprites que pasan el culling.
+    const ComponentPool<TimedSpriteAnimator>* timed = creg.storage<TimedSpriteAnimator>();
+    const AnimationLibrary* library = ctx.animations;
+    if (!library) timed = nullptr;
+
+    auto drawSprite = [&](uint32_t i) {
+        const Entity e = sprites->denseEntities()[i];
+        const Sprite& spr = sprites->denseComponents()[i];
+        glm::vec2 renderPos;
+        if (!spritePosition(e, renderPos)) return;
+
+        if (std::abs(renderPos.x - camPos.x) > halfW + spr.width * 0.5f ||
+            std::abs(renderPos.y - camPos.y) > halfH + spr.height * 0.5f) {
+            return;
+        }
 
         eng::Rect uv = spr.uvRect;
+        const uint32_t ti = timed ? timed->denseIndex(e) : IComponentPool::InvalidDense;
+        if (ti != IComponentPool::InvalidDense) {
+            const TimedSpriteAnimator& anim = timed->denseComponents()[ti];
+            if (library->valid(anim.clipSet) && anim.clip < library->clipCount(anim.clipSet)) {
+                const AnimationLibrary::Clip& clip = library->clip(anim.clipSet, anim.clip);
+                if (clip.frameCount > 0) {
+                    const double elapsed = (library->now() - anim.startTime) * anim.speed;
+                    uv = library->frame(clip, AnimationLibrary::frameIndexAt(clip, elapsed));
+                }
+            }
+        }
         if (spr.flipX) {
             uv.x = uv.x + uv.w;
             uv.w = -uv.w;
         }
+        r.submitTexturedQuad(renderPos, spr.width, spr.height,
+                             ctx.textures->glId(spr.texture), uv, spr.tint);
+    };
 
-        // sortY = borde inferior del sprite (centro + mitad de altura)
-        float sortY = renderPos.y + spr.height * 0.5f;
-
-        spriteEntries.push_back({sortY, renderPos, glId, uv,
-                                 spr.width, spr.height, spr.tint});
-    }
-
-    // Ordenar: menor Y primero (mas lejos), mayor Y despues (mas cerca, se dibuja encima)
-    std::sort(spriteEntries.begin(), spriteEntries.end(),
-              [](const SpriteEntry& a, const SpriteEntry& b) {
-                  return a.sortY < b.sortY;
-              });
-
-    for (const auto& se : spriteEntries) {
-        r.submitTexturedQuad(se.renderPos, se.width, se.height,
-                             se.glId, se.uv, se.tint);
+    // Sprite es de un owning group (animados al frente), asi que el pool
+    // tiene dos tramos ordenados: [0, grouped) y [grouped, size). Se
+    // mezclan al recorrerlos.
+    {
+        eng::ScopeTimer timer(ctx.profiler, s_spritesZone);
+        const uint32_t grouped = static_cast<uint32_t>(creg.groupedCount<Sprite>());
+        const uint32_t total = static_cast<uint32_t>(sprites->size());
+        uint32_t a = 0, b = grouped;
+        while (a < grouped && b < total) {
+            if (sortY(sprites->denseEntities()[b]) < sortY(sprites->denseEntities()[a])) {
+                drawSprite(b++);
+            } else {
+                drawSprite(a++);
+            }
+        }
+        while (a < grouped) drawSprite(a++);
+        while (b < total) drawSprite(b++);
     }
 
+    eng::ScopeTimer timer(ctx.profiler, s_flushZone);
     r.flush();
 }
 
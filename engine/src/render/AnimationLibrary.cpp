@@ -0,0 +1,42 @@
+#include "engine/render/AnimationLibrary.h"
+
+namespace eng {
+
+ClipSetHandle AnimationLibrary::addClipSet(std::span<const AnimationClip> clips) {
+    ClipSet set;
+    set.firstClip = static_cast<uint32_t>(m_clips.size());
+    set.clipCount = static_cast<uint32_t>(clips.size());
+
+    for (const AnimationClip& src : clips) {
+        assert(src.frameDuration > 0.0f && "Animation clip needs a positive frameDuration!");
+        Clip c;
+        c.firstFrame = static_cast<uint32_t>(m_frames.size());
+        c.frameCount = static_cast<uint32_t>(src.frames.size());
+        c.frameDuration = src.frameDuration;
+        c.loop = src.loop;
+        m_frames.insert(m_frames.end(), src.frames.begin(), src.frames.end());
+        m_clips.push_back(c);
+        m_clipNames.push_back(src.name);
+    }
+
+    m_sets.push_back(set);
+    return static_cast<ClipSetHandle>(m_sets.size() - 1);
+}
+
+int AnimationLibrary::findClip(ClipSetHandle set, std::string_view name) const {
+    if (!valid(set)) return -1;
+    const ClipSet& s = m_sets[set];
+    for (uint32_t i = 0; i < s.clipCount; ++i) {
+        if (m_clipNames[s.firstClip + i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void AnimationLibrary::clear() {
+    m_frames.clear();
+    m_clips.clear();
+    m_clipNames.clear();
+    m_sets.clear();
+}
+
+} // namespace eng
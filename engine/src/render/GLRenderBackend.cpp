@@ -0,0 +1,254 @@
+#include "engine/render/GLRenderBackend.h"
+#include <SDL.h>
+
+#include <string>
+#include <cassert>
+#include <cstddef>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+#include <glad/glad.h>
+
+namespace eng {
+
+// Mismo limite que Renderer2D::MaxTextureSlots (el shader tiene 16 samplers).
+static constexpr int MaxTextureUnits = 16;
+
+// ────────────────────────────────────────────────────────────────
+// Shaders
+// ────────────────────────────────────────────────────────────────
+
+static const char* kVS = R"(
+#version 330 core
+layout(location=0) in vec2 aPos;
+layout(location=1) in vec4 aColor;
+layout(location=2) in vec2 aTexCoord;
+layout(location=3) in int  aTexIndex;
+
+out vec4 vColor;
+out vec2 vTexCoord;
+flat out int vTexIndex;
+
+uniform vec2 uScreenSize; // pixels
+
+void main() {
+    // aPos esta en pixels ya. Convertimos pixels -> NDC
+    vec2 ndc = vec2(
+        (aPos.x / uScreenSize.x) * 2.0 - 1.0,
+        1.0 - (aPos.y / uScreenSize.y) * 2.0
+    );
+    gl_Position = vec4(ndc, 0.0, 1.0);
+    vColor    = aColor;
+    vTexCoord = aTexCoord;
+    vTexIndex = aTexIndex;
+}
+)";
+
+static const char* kFS = R"(
+#version 330 core
+in vec4 vColor;
+in vec2 vTexCoord;
+flat in int vTexIndex;
+
+out vec4 FragColor;
+
+uniform sampler2D uTextures[16];
+
+void main() {
+    // Indexar sampler arrays con una variable no-constante es undefined behavior
+    // en GLSL 330 (algunos drivers lo permiten, otros no). Usamos un switch
+    // explicito que el compilador puede optimizar a una tabla de saltos.
+    vec4 texColor;
+    switch (vTexIndex) {
+        case  0: texColor = texture(uTextures[ 0], vTexCoord); break;
+        case  1: texColor = texture(uTextures[ 1], vTexCoord); break;
+        case  2: texColor = texture(uTextures[ 2], vTexCoord); break;
+        case  3: texColor = texture(uTextures[ 3], vTexCoord); break;
+        case  4: texColor = texture(uTextures[ 4], vTexCoord); break;
+        case  5: texColor = texture(uTextures[ 5], vTexCoord); break;
+        case  6: texColor = texture(uTextures[ 6], vTexCoord); break;
+        case  7: texColor = texture(uTextures[ 7], vTexCoord); break;
+        case  8: texColor = texture(uTextures[ 8], vTexCoord); break;
+        case  9: texColor = texture(uTextures[ 9], vTexCoord); break;
+        case 10: texColor = texture(uTextures[10], vTexCoord); break;
+        case 11: texColor = texture(uTextures[11], vTexCoord); break;
+        case 12: texColor = texture(uTextures[12], vTexCoord); break;
+        case 13: texColor = texture(uTextures[13], vTexCoord); break;
+        case 14: texColor = texture(uTextures[14], vTexCoord); break;
+        case 15: texColor = texture(uTextures[15], vTexCoord); break;
+        default: texColor = texture(uTextures[ 0], vTexCoord); break;
+    }
+    FragColor = texColor * vColor;
+}
+)";
+
+// ────────────────────────────────────────────────────────────────
+// Shader compile/link
+// ────────────────────────────────────────────────────────────────
+
+uint32_t GLRenderBackend::compileShader(uint32_t type, const char* src) {
+    GLuint s = glCreateShader(type);
+    glShaderSource(s, 1, &src, nullptr);
+    glCompileShader(s);
+
+    GLint ok = 0;
+    glGetShaderiv(s, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        GLint len = 0;
+        glGetShaderiv(s, GL_INFO_LOG_LENGTH, &len);
+        std::string log;
+        log.resize((size_t)len);
+        glGetShaderInfoLog(s, len, nullptr, log.data());
+        SDL_Log("Renderer2D shader compile error: %s", log.c_str());
+        glDeleteShader(s);
+        return 0;
+    }
+    return (uint32_t)s;
+}
+
+uint32_t GLRenderBackend::linkProgram(uint32_t vs, uint32_t fs) {
+    GLuint p = glCreateProgram();
+    glAttachShader(p, vs);
+    glAttachShader(p, fs);
+    glLinkProgram(p);
+
+    GLint ok = 0;
+    glGetProgramiv(p, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        GLint len = 0;
+        glGetProgramiv(p, GL_INFO_LOG_LENGTH, &len);
+        std::string log;
+        log.resize((size_t)len);
+        glGetProgramInfoLog(p, len, nullptr, log.data());
+        SDL_Log("Renderer2D program link error: %s", log.c_str());
+        glDeleteProgram(p);
+        return 0;
+    }
+    return (uint32_t)p;
+}
+
+// ────────────────────────────────────────────────────────────────
+// Init / Shutdown
+// ────────────────────────────────────────────────────────────────
+
+void GLRenderBackend::init() {
+    if (m_program != 0) return;
+
+    uint32_t vs = compileShader(GL_VERTEX_SHADER, kVS);
+    uint32_t fs = compileShader(GL_FRAGMENT_SHADER, kFS);
+    assert(vs && fs);
+
+    m_program = linkProgram(vs, fs);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    assert(m_program);
+
+    // Cachear uniform locations
+    m_locScreenSize = glGetUniformLocation(m_program, "uScreenSize");
+
+    // Setear los samplers uTextures[i] = i (una sola vez, despues de linkear)
+    glUseProgram(m_program);
+    for (int i = 0; i < MaxTextureUnits; ++i) {
+        std::string name = "uTextures[" + std::to_string(i) + "]";
+        GLint loc = glGetUniformLocation(m_program, name.c_str());
+        glUniform1i(loc, i);
+    }
+    glUseProgram(0);
+
+    // ── VAO / VBO ──
+    glGenVertexArrays(1, &m_vao);
+    glGenBuffers(1, &m_vbo);
+
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+
+    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
+
+    // location 0: position (x, y)
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex2D),
+                          (void*)offsetof(Vertex2D, x));
+
+    // location 1: color (r, g, b, a)
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex2D),
+                          (void*)offsetof(Vertex2D, r));
+
+    // location 2: texCoord (u, v)
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex2D),
+                          (void*)offsetof(Vertex2D, u));
+
+    // location 3: texIndex (entero — usa IPointer, no la version float)
+    glEnableVertexAttribArray(3);
+    glVertexAttribIPointer(3, 1, GL_INT, sizeof(Vertex2D),
+                           (void*)offsetof(Vertex2D, texIndex));
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    // ── Textura dummy blanca (1x1) para quads de color solido ──
+    glGenTextures(1, &m_whiteTexture);
+    glBindTexture(GL_TEXTURE_2D, m_whiteTexture);
+    const uint32_t white = 0xFFFFFFFF;
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, &white);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // ── Alpha blending (necesario para texturas con transparencia) ──
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void GLRenderBackend::shutdown() {
+    if (m_whiteTexture) glDeleteTextures(1, &m_whiteTexture);
+    if (m_vbo)          glDeleteBuffers(1, &m_vbo);
+    if (m_vao)          glDeleteVertexArrays(1, &m_vao);
+    if (m_program)      glDeleteProgram(m_program);
+    m_whiteTexture = 0;
+    m_vbo = m_vao = m_program = 0;
+}
+
+// ────────────────────────────────────────────────────────────────
+// Draw
+// ────────────────────────────────────────────────────────────────
+
+void GLRenderBackend::draw(const RenderBatch& batch) {
+    glUseProgram(m_program);
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+
+    glBufferData(GL_ARRAY_BUFFER,
+                 (GLsizeiptr)(batch.vertexCount * sizeof(Vertex2D)),
+                 batch.vertices,
+                 GL_DYNAMIC_DRAW);
+
+    glUniform2f(m_locScreenSize, (float)batch.screenW, (float)batch.screenH);
+
+    // Bindear todas las texturas activas a sus texture units
+    for (int i = 0; i < batch.textureCount; ++i) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, batch.textures[i]);
+    }
+
+    glDrawArrays(GL_TRIANGLES, 0, (GLsizei)batch.vertexCount);
+
+    // Limpiar bindings
+    for (int i = 0; i < batch.textureCount; ++i) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    glActiveTexture(GL_TEXTURE0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    glUseProgram(0);
+}
+
+} // namespace eng
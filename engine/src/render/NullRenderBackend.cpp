@@ -0,0 +1,34 @@
+#include "engine/render/NullRenderBackend.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace eng {
+
+void NullRenderBackend::draw(const RenderBatch& batch) {
+    ++m_drawCount;
+    m_vertexCount += batch.vertexCount;
+    m_uploadBytes += static_cast<uint64_t>(batch.vertexCount) * sizeof(Vertex2D);
+    if (!m_capture) return;
+
+    assert(batch.textureCount <= 16 && "NullRenderBackend: too many texture units!");
+    Draw d;
+    d.firstVertex = static_cast<uint32_t>(m_vertices.size());
+    d.vertexCount = batch.vertexCount;
+    d.textureCount = std::min(batch.textureCount, 16);
+    std::copy(batch.textures, batch.textures + d.textureCount, d.textures.begin());
+    d.screenW = batch.screenW;
+    d.screenH = batch.screenH;
+    m_draws.push_back(d);
+    m_vertices.insert(m_vertices.end(), batch.vertices, batch.vertices + batch.vertexCount);
+}
+
+void NullRenderBackend::reset() {
+    m_drawCount = 0;
+    m_vertexCount = 0;
+    m_uploadBytes = 0;
+    m_draws.clear();
+    m_vertices.clear();
+}
+
+} // namespace eng
@@ -0,0 +1,124 @@
+#include "engine/render/RenderPipeline.h"
+#include "engine/render/Renderer2D.h"
+
+#include <glad/glad.h>
+#include <imgui.h>
+#include <backends/imgui_impl_opengl3.h>
+
+#include <cassert>
+
+namespace eng {
+
+// ────────────────────────────────────────────────────────────────
+// FrameSnapshot
+// ────────────────────────────────────────────────────────────────
+
+FrameSnapshot::~FrameSnapshot() {
+    clearUi();
+}
+
+void FrameSnapshot::clearUi() {
+    for (ImDrawList* list : uiLists) IM_DELETE(list);
+    uiLists.clear();
+}
+
+void FrameSnapshot::captureUi(const ImDrawData* drawData) {
+    clearUi();
+    if (!drawData || !drawData->Valid) return;
+
+    uiDisplayPos[0] = drawData->DisplayPos.x;
+    uiDisplayPos[1] = drawData->DisplayPos.y;
+    uiDisplaySize[0] = drawData->DisplaySize.x;
+    uiDisplaySize[1] = drawData->DisplaySize.y;
+    uiFramebufferScale[0] = drawData->FramebufferScale.x;
+    uiFramebufferScale[1] = drawData->FramebufferScale.y;
+
+    uiLists.reserve(static_cast<size_t>(drawData->CmdListsCount));
+    for (int i = 0; i < drawData->CmdListsCount; ++i) {
+        uiLists.push_back(drawData->CmdLists[i]->CloneOutput());
+    }
+}
+
+// ────────────────────────────────────────────────────────────────
+// RenderPipeline
+// ────────────────────────────────────────────────────────────────
+
+RenderPipeline::RenderPipeline(SDL_Window* window, SDL_GLContext context, Renderer2D& renderer,
+                               Profiler& profiler)
+    : m_window(window), m_context(context), m_renderer(renderer), m_profiler(profiler),
+      m_zone(profiler.registerZone("RenderThread")) {
+    // El contexto GL solo puede estar activo en un thread a la vez.
+    SDL_GL_MakeCurrent(m_window, nullptr);
+    m_thread = std::thread([this] { renderLoop(); });
+}
+
+RenderPipeline::~RenderPipeline() {
+    m_mailbox.fetch_or(StopBit, std::memory_order_acq_rel);
+    m_mailbox.notify_all();
+    m_thread.join();
+    SDL_GL_MakeCurrent(m_window, m_context);
+}
+
+void RenderPipeline::publish() {
+    // El slot escrito pasa al buzon y el que estaba en el buzon (ya
+    // tomado o nunca usado) pasa a ser el proximo a escribir.
+    const uint32_t prev = m_mailbox.exchange(m_writeSlot | FreshBit, std::memory_order_acq_rel);
+    assert(!(prev & FreshBit) && "RenderPipeline: previous frame was never picked up!");
+    m_writeSlot = prev & SlotMask;
+    m_mailbox.notify_all();
+
+    // Un frame de adelanto como maximo: esperar a que el render thread lo
+    // tome (lo hace apenas termina de dibujar el anterior).
+    uint32_t box = m_mailbox.load(std::memory_order_acquire);
+    while ((box & FreshBit) && !(box & StopBit)) {
+        m_mailbox.wait(box, std::memory_order_acquire);
+        box = m_mailbox.load(std::memory_order_acquire);
+    }
+}
+
+void RenderPipeline::renderLoop() {
+    Profiler::setThreadName("Render");
+    SDL_GL_MakeCurrent(m_window, m_context);
+
+    for (;;) {
+        uint32_t box = m_mailbox.load(std::memory_order_acquire);
+        while (!(box & (FreshBit | StopBit))) {
+            m_mailbox.wait(box, std::memory_order_acquire);
+            box = m_mailbox.load(std::memory_order_acquire);
+        }
+        if (box & StopBit) break;
+
+        // Tomar el frame del buzon y dejar el slot ya dibujado. CAS y no
+        // exchange: no pisar un StopBit que llegue en el medio.
+        if (!m_mailbox.compare_exchange_weak(box, m_readSlot, std::memory_order_acq_rel)) continue;
+        m_readSlot = box & SlotMask;
+        m_mailbox.notify_all();
+
+        ScopeTimer t(m_profiler, m_zone);
+        draw(m_frames[m_readSlot]);
+    }
+
+    SDL_GL_MakeCurrent(m_window, nullptr);
+}
+
+void RenderPipeline::draw(FrameSnapshot& frame) {
+    glViewport(0, 0, frame.drawableW, frame.drawableH);
+    glClearColor(0.08f, 0.08f, 0.10f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    m_renderer.replay(frame.render);
+
+    if (!frame.uiLists.empty()) {
+        ImDrawData drawData;
+        drawData.Valid = true;
+        drawData.DisplayPos = ImVec2(frame.uiDisplayPos[0], frame.uiDisplayPos[1]);
+        drawData.DisplaySize = ImVec2(frame.uiDisplaySize[0], frame.uiDisplaySize[1]);
+        drawData.FramebufferScale = ImVec2(frame.uiFramebufferScale[0], frame.uiFramebufferScale[1]);
+        for (ImDrawList* list : frame.uiLists) drawData.AddDrawList(list);
+        ImGui_ImplOpenGL3_RenderDrawData(&drawData);
+    }
+
+    SDL_GL_SwapWindow(m_window);
+}
+
+} // namespace eng
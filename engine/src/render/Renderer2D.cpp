@@ -1,216 +1,29 @@
 #include "engine/render/Renderer2D.h"
 #include "engine/ecs/Components.h"
-#include <SDL.h>
 
-#include <string>
 #include <cassert>
 #include <cmath>
 
-#ifdef _WIN32
-#include <Windows.h>
-#endif
-
-#include <glad/glad.h>
-
 namespace eng {
 
 // ────────────────────────────────────────────────────────────────
-// Shaders
-// ────────────────────────────────────────────────────────────────
-
-static const char* kVS = R"(
-#version 330 core
-layout(location=0) in vec2 aPos;
-layout(location=1) in vec4 aColor;
-layout(location=2) in vec2 aTexCoord;
-layout(location=3) in int  aTexIndex;
-
-out vec4 vColor;
-out vec2 vTexCoord;
-flat out int vTexIndex;
-
-uniform vec2 uScreenSize; // pixels
-
-void main() {
-    // aPos esta en pixels ya. Convertimos pixels -> NDC
-    vec2 ndc = vec2(
-        (aPos.x / uScreenSize.x) * 2.0 - 1.0,
-        1.0 - (aPos.y / uScreenSize.y) * 2.0
-    );
-    gl_Position = vec4(ndc, 0.0, 1.0);
-    vColor    = aColor;
-    vTexCoord = aTexCoord;
-    vTexIndex = aTexIndex;
-}
-)";
-
-static const char* kFS = R"(
-#version 330 core
-in vec4 vColor;
-in vec2 vTexCoord;
-flat in int vTexIndex;
-
-out vec4 FragColor;
-
-uniform sampler2D uTextures[16];
-
-void main() {
-    // Indexar sampler arrays con una variable no-constante es undefined behavior
-    // en GLSL 330 (algunos drivers lo permiten, otros no). Usamos un switch
-    // explicito que el compilador puede optimizar a una tabla de saltos.
-    vec4 texColor;
-    switch (vTexIndex) {
-        case  0: texColor = texture(uTextures[ 0], vTexCoord); break;
-        case  1: texColor = texture(uTextures[ 1], vTexCoord); break;
-        case  2: texColor = texture(uTextures[ 2], vTexCoord); break;
-        case  3: texColor = texture(uTextures[ 3], vTexCoord); break;
-        case  4: texColor = texture(uTextures[ 4], vTexCoord); break;
-        case  5: texColor = texture(uTextures[ 5], vTexCoord); break;
-        case  6: texColor = texture(uTextures[ 6], vTexCoord); break;
-        case  7: texColor = texture(uTextures[ 7], vTexCoord); break;
-        case  8: texColor = texture(uTextures[ 8], vTexCoord); break;
-        case  9: texColor = texture(uTextures[ 9], vTexCoord); break;
-        case 10: texColor = texture(uTextures[10], vTexCoord); break;
-        case 11: texColor = texture(uTextures[11], vTexCoord); break;
-        case 12: texColor = texture(uTextures[12], vTexCoord); break;
-        case 13: texColor = texture(uTextures[13], vTexCoord); break;
-        case 14: texColor = texture(uTextures[14], vTexCoord); break;
-        case 15: texColor = texture(uTextures[15], vTexCoord); break;
-        default: texColor = texture(uTextures[ 0], vTexCoord); break;
-    }
-    FragColor = texColor * vColor;
-}
-)";
-
-// ────────────────────────────────────────────────────────────────
-// Shader compile/link (sin cambios)
+// Init / Shutdown
 // ────────────────────────────────────────────────────────────────
 
-uint32_t Renderer2D::compileShader(uint32_t type, const char* src) {
-    GLuint s = glCreateShader(type);
-    glShaderSource(s, 1, &src, nullptr);
-    glCompileShader(s);
-
-    GLint ok = 0;
-    glGetShaderiv(s, GL_COMPILE_STATUS, &ok);
-    if (!ok) {
-        GLint len = 0;
-        glGetShaderiv(s, GL_INFO_LOG_LENGTH, &len);
-        std::string log;
-        log.resize((size_t)len);
-        glGetShaderInfoLog(s, len, nullptr, log.data());
-        SDL_Log("Renderer2D shader compile error: %s", log.c_str());
-        glDeleteShader(s);
-        return 0;
-    }
-    return (uint32_t)s;
-}
-
-uint32_t Renderer2D::linkProgram(uint32_t vs, uint32_t fs) {
-    GLuint p = glCreateProgram();
-    glAttachShader(p, vs);
-    glAttachShader(p, fs);
-    glLinkProgram(p);
-
-    GLint ok = 0;
-    glGetProgramiv(p, GL_LINK_STATUS, &ok);
-    if (!ok) {
-        GLint len = 0;
-        glGetProgramiv(p, GL_INFO_LOG_LENGTH, &len);
-        std::string log;
-        log.resize((size_t)len);
-        glGetProgramInfoLog(p, len, nullptr, log.data());
-        SDL_Log("Renderer2D program link error: %s", log.c_str());
-        glDeleteProgram(p);
-        return 0;
-    }
-    return (uint32_t)p;
-}
+Renderer2D::Renderer2D()
+    : m_backend(&m_glBackend) {}
 
-// ────────────────────────────────────────────────────────────────
-// Init / Shutdown
-// ────────────────────────────────────────────────────────────────
+Renderer2D::Renderer2D(RenderBackend& backend)
+    : m_backend(&backend) {}
 
 void Renderer2D::init() {
-    if (m_program != 0) return;
-
-    uint32_t vs = compileShader(GL_VERTEX_SHADER, kVS);
-    uint32_t fs = compileShader(GL_FRAGMENT_SHADER, kFS);
-    assert(vs && fs);
-
-    m_program = linkProgram(vs, fs);
-    glDeleteShader(vs);
-    glDeleteShader(fs);
-    assert(m_program);
-
-    // Cachear uniform locations
-    m_locScreenSize = glGetUniformLocation(m_program, "uScreenSize");
-
-    // Setear los samplers uTextures[i] = i (una sola vez, despues de linkear)
-    glUseProgram(m_program);
-    for (int i = 0; i < MaxTextureSlots; ++i) {
-        std::string name = "uTextures[" + std::to_string(i) + "]";
-        GLint loc = glGetUniformLocation(m_program, name.c_str());
-        glUniform1i(loc, i);
-    }
-    glUseProgram(0);
-
-    // ── VAO / VBO ──
-    glGenVertexArrays(1, &m_vao);
-    glGenBuffers(1, &m_vbo);
-
-    glBindVertexArray(m_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-
-    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
-
-    // location 0: position (x, y)
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          (void*)offsetof(Vertex, x));
-
-    // location 1: color (r, g, b, a)
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          (void*)offsetof(Vertex, r));
-
-    // location 2: texCoord (u, v)
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          (void*)offsetof(Vertex, u));
-
-    // location 3: texIndex (entero — usa IPointer, no la version float)
-    glEnableVertexAttribArray(3);
-    glVertexAttribIPointer(3, 1, GL_INT, sizeof(Vertex),
-                           (void*)offsetof(Vertex, texIndex));
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-
-    // ── Textura dummy blanca (1x1) para quads de color solido ──
-    glGenTextures(1, &m_whiteTexture);
-    glBindTexture(GL_TEXTURE_2D, m_whiteTexture);
-    const uint32_t white = 0xFFFFFFFF;
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0,
-                 GL_RGBA, GL_UNSIGNED_BYTE, &white);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    // ── Alpha blending (necesario para texturas con transparencia) ──
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    m_backend->init();
+    m_whiteTexture = m_backend->whiteTexture();
 }
 
 void Renderer2D::shutdown() {
-    if (m_whiteTexture) glDeleteTextures(1, &m_whiteTexture);
-    if (m_vbo)          glDeleteBuffers(1, &m_vbo);
-    if (m_vao)          glDeleteVertexArrays(1, &m_vao);
-    if (m_program)      glDeleteProgram(m_program);
+    m_backend->shutdown();
     m_whiteTexture = 0;
-    m_vbo = m_vao = m_program = 0;
 }
 
 // ────────────────────────────────────────────────────────────────
@@ -218,9 +31,18 @@ void Renderer2D::shutdown() {
 // ────────────────────────────────────────────────────────────────
 
 void Renderer2D::beginFrame(int screenW, int screenH) {
+    if (m_recording) {
+        m_recording->beginFrame(screenW, screenH);
+        return;
+    }
+    beginFrameImpl(screenW, screenH);
+}
+
+void Renderer2D::beginFrameImpl(int screenW, int screenH) {
     m_screenW = (screenW > 0) ? screenW : 1;
     m_screenH = (screenH > 0) ? screenH : 1;
     m_vertices.clear();
+    m_stats = {};
 
     // Resetear texture slots — slot 0 siempre es la textura dummy blanca
     m_textureSlots.fill(0);
@@ -228,7 +50,41 @@ void Renderer2D::beginFrame(int screenW, int screenH) {
     m_textureSlotCount = 1;
 }
 
+void Renderer2D::endFrame() {
+    if (m_recording) {
+        m_recording->endFrame();
+        return;
+    }
+    endFrameImpl();
+}
+
+void Renderer2D::endFrameImpl() {
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        m_lastStats = m_stats;
+        ++m_statsFrame;
+    }
+
+    if (m_profiler) {
+        m_profiler->submitCounter(m_counters.drawCalls, m_stats.drawCalls);
+        m_profiler->submitCounter(m_counters.flushes, m_stats.flushes);
+        m_profiler->submitCounter(m_counters.slotOverflows, m_stats.slotOverflows);
+        m_profiler->submitCounter(m_counters.textureBinds, m_stats.textureBinds);
+        m_profiler->submitCounter(m_counters.quads, m_stats.quads);
+        m_profiler->submitCounter(m_counters.vertices, m_stats.vertices);
+        m_profiler->submitCounter(m_counters.uploadBytes, static_cast<double>(m_stats.uploadBytes));
+    }
+}
+
 void Renderer2D::setCamera(glm::vec2 centerWorld, float pixelsPerUnit) {
+    if (m_recording) {
+        m_recording->setCamera(centerWorld, pixelsPerUnit);
+        return;
+    }
+    setCameraImpl(centerWorld, pixelsPerUnit);
+}
+
+void Renderer2D::setCameraImpl(glm::vec2 centerWorld, float pixelsPerUnit) {
     m_camCenter = centerWorld;
     m_ppu = (pixelsPerUnit > 1.0f) ? pixelsPerUnit : 1.0f;
 }
@@ -247,6 +103,7 @@ int Renderer2D::getTextureSlot(uint32_t glTexId) {
 
     // Si los slots estan llenos, hacer un flush intermedio
     if (m_textureSlotCount >= MaxTextureSlots) {
+        ++m_stats.slotOverflows;
         flushBatch();
         // Despues del flush, resetear slots (slot 0 = white)
         m_textureSlots.fill(0);
@@ -278,7 +135,18 @@ void Renderer2D::submitQuad(glm::vec2 centerWorld, float wWorld, float hWorld,
 void Renderer2D::submitTexturedQuad(glm::vec2 centerWorld, float wWorld, float hWorld,
                                      uint32_t glTexId, const Rect& uv,
                                      eng::ecs::Color4 tint) {
+    if (m_recording) {
+        m_recording->quad({centerWorld, wWorld, hWorld, glTexId, uv, tint});
+        return;
+    }
+    submitTexturedQuadImpl(centerWorld, wWorld, hWorld, glTexId, uv, tint);
+}
+
+void Renderer2D::submitTexturedQuadImpl(glm::vec2 centerWorld, float wWorld, float hWorld,
+                                        uint32_t glTexId, const Rect& uv,
+                                        eng::ecs::Color4 tint) {
     int texIdx = getTextureSlot(glTexId);
+    ++m_stats.quads;
 
     // World -> Screen(pixels)
     const float cx = (centerWorld.x - m_camCenter.x) * m_ppu + (float)m_screenW * 0.5f;
@@ -322,43 +190,100 @@ void Renderer2D::submitTexturedQuad(glm::vec2 centerWorld, float wWorld, float h
 // ────────────────────────────────────────────────────────────────
 
 void Renderer2D::flushBatch() {
+    ++m_stats.flushes;
     if (m_vertices.empty()) return;
 
-    glUseProgram(m_program);
-    glBindVertexArray(m_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    const uint32_t vertexCount = static_cast<uint32_t>(m_vertices.size());
+    ++m_stats.drawCalls;
+    m_stats.vertices += vertexCount;
+    m_stats.uploadBytes += static_cast<uint64_t>(vertexCount) * sizeof(Vertex);
+    m_stats.textureBinds += static_cast<uint32_t>(m_textureSlotCount);
+
+    RenderBatch batch;
+    batch.vertices = m_vertices.data();
+    batch.vertexCount = vertexCount;
+    batch.textures = m_textureSlots.data();
+    batch.textureCount = m_textureSlotCount;
+    batch.screenW = m_screenW;
+    batch.screenH = m_screenH;
+    m_backend->draw(batch);
 
-    glBufferData(GL_ARRAY_BUFFER,
-                 (GLsizeiptr)(m_vertices.size() * sizeof(Vertex)),
-                 m_vertices.data(),
-                 GL_DYNAMIC_DRAW);
-
-    glUniform2f(m_locScreenSize, (float)m_screenW, (float)m_screenH);
+    m_vertices.clear();
+}
 
-    // Bindear todas las texturas activas a sus texture units
-    for (int i = 0; i < m_textureSlotCount; ++i) {
-        glActiveTexture(GL_TEXTURE0 + i);
-        glBindTexture(GL_TEXTURE_2D, m_textureSlots[i]);
+void Renderer2D::flush() {
+    if (m_recording) {
+        m_recording->flush();
+        return;
     }
+    flushBatch();
+}
 
-    glDrawArrays(GL_TRIANGLES, 0, (GLsizei)m_vertices.size());
+// ────────────────────────────────────────────────────────────────
+// Grabacion / replay
+// ────────────────────────────────────────────────────────────────
 
-    // Limpiar bindings
-    for (int i = 0; i < m_textureSlotCount; ++i) {
-        glActiveTexture(GL_TEXTURE0 + i);
-        glBindTexture(GL_TEXTURE_2D, 0);
+void Renderer2D::beginRecording(RenderSnapshot& snapshot) {
+    assert(!m_recording && "Renderer2D is already recording!");
+    snapshot.clear();
+    m_recording = &snapshot;
+}
+
+void Renderer2D::endRecording() {
+    m_recording = nullptr;
+}
+
+void Renderer2D::replay(const RenderSnapshot& snapshot) {
+    // Va directo a las *Impl: en el modo pipelined el main thread puede
+    // estar grabando el proximo frame en este mismo renderer.
+    for (const RenderSnapshot::Command& c : snapshot.commands) {
+        switch (c.op) {
+            case RenderSnapshot::Op::BeginFrame:
+                beginFrameImpl(c.screenW, c.screenH);
+                break;
+            case RenderSnapshot::Op::SetCamera:
+                setCameraImpl(c.camCenter, c.ppu);
+                break;
+            case RenderSnapshot::Op::Quads:
+                for (uint32_t i = c.first; i < c.first + c.count; ++i) {
+                    const RenderSnapshot::Quad& q = snapshot.quads[i];
+                    submitTexturedQuadImpl(q.center, q.w, q.h, q.glTexId, q.uv, q.tint);
+                }
+                break;
+            case RenderSnapshot::Op::Flush:
+                flushBatch();
+                break;
+            case RenderSnapshot::Op::EndFrame:
+                endFrameImpl();
+                break;
+        }
     }
-    glActiveTexture(GL_TEXTURE0);
+}
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-    glUseProgram(0);
+// ────────────────────────────────────────────────────────────────
+// Stats
+// ────────────────────────────────────────────────────────────────
 
-    m_vertices.clear();
+RendererStats Renderer2D::stats() const {
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    return m_lastStats;
 }
 
-void Renderer2D::flush() {
-    flushBatch();
+uint64_t Renderer2D::statsFrame() const {
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    return m_statsFrame;
+}
+
+void Renderer2D::setProfiler(Profiler* profiler) {
+    m_profiler = profiler;
+    if (!profiler) return;
+    m_counters.drawCalls     = profiler->registerCounter("Renderer/DrawCalls");
+    m_counters.flushes       = profiler->registerCounter("Renderer/Flushes");
+    m_counters.slotOverflows = profiler->registerCounter("Renderer/SlotOverflows");
+    m_counters.textureBinds  = profiler->registerCounter("Renderer/TextureBinds");
+    m_counters.quads         = profiler->registerCounter("Renderer/Quads");
+    m_counters.vertices      = profiler->registerCounter("Renderer/Vertices");
+    m_counters.uploadBytes   = profiler->registerCounter("Renderer/UploadBytes");
 }
 
 } // namespace eng
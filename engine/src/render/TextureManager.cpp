@@ -103,6 +103,12 @@ TextureHandle TextureManager::load(const std::string& path) {
     return handle;
 }
 
+TextureHandle TextureManager::add(const Texture& texture) {
+    const TextureHandle handle = static_cast<TextureHandle>(m_textures.size());
+    m_textures.push_back(texture);
+    return handle;
+}
+
 const Texture& TextureManager::get(TextureHandle h) const {
     assert(h < m_textures.size() && "Invalid TextureHandle");
     return m_textures[h];